@@ -0,0 +1,237 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_BASE32_CROCKFORD_CHECK
+#define CPPCODEC_BASE32_CROCKFORD_CHECK
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base32_crockford.hpp"
+#include "data/access.hpp"
+#include "data/checksum_result_buffer.hpp"
+#include "data/null_result_buffer.hpp"
+#include "parse_error.hpp"
+
+namespace cppcodec {
+
+namespace detail {
+
+template <typename Codec, typename CodecVariant> class crockford_check_codec;
+
+// The 32 data symbols plus five more that only occur as check symbol.
+static constexpr const char base32_crockford_check_alphabet[] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', // at index 10
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H',           // 18 - no I
+    'J', 'K',                                         // 20 - no L
+    'M', 'N',                                         // 22 - no O
+    'P', 'Q', 'R', 'S', 'T',                          // 27 - no U
+    'V', 'W', 'X', 'Y', 'Z',                          // 32
+    '*', '~', '$', '=', 'U'                           // 37 - check symbols only
+};
+
+// base32_crockford with the optional check symbol appended to the encoded data.
+// The check symbol encodes the binary data, read as one big-endian number, modulo 37.
+class base32_crockford_check : public base32_crockford_base
+{
+public:
+    template <typename Codec> using codec_impl = crockford_check_codec<Codec, base32_crockford_check>;
+
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t alphabet_size() {
+        static_assert(sizeof(base32_crockford_check_alphabet) == 37,
+                "base32 check alphabet must have 37 values");
+        return sizeof(base32_crockford_check_alphabet);
+    }
+    static CPPCODEC_ALWAYS_INLINE constexpr char symbol(alphabet_index_t idx)
+    {
+        return base32_crockford_check_alphabet[idx];
+    }
+};
+
+// Computes the remainder modulo 37 of a big-endian number that is passed in pieces.
+// As 2^36 = 1 (mod 37), each 72-bit group of nine bytes adds the sum of its two 36-bit halves
+// to the remainder, no matter how many bytes come before it. That needs no division per byte.
+class crockford_checksum
+{
+public:
+    void update(const uint8_t* data, size_t size) noexcept
+    {
+        // Reduce often enough that the sum of 36-bit halves can't overflow.
+        constexpr const size_t max_groups = size_t(1) << 20;
+
+        uint64_t sum = m_remainder;
+        while (size >= 9) {
+            size_t num_groups = size / 9 < max_groups ? size / 9 : max_groups;
+            for (size_t i = 0; i < num_groups; ++i, data += 9) {
+                uint64_t hi = (static_cast<uint64_t>(data[0]) << 28) | (static_cast<uint64_t>(data[1]) << 20)
+                        | (static_cast<uint64_t>(data[2]) << 12) | (static_cast<uint64_t>(data[3]) << 4)
+                        | (data[4] >> 4);
+                uint64_t lo = (static_cast<uint64_t>(data[4] & 0xF) << 32)
+                        | (static_cast<uint64_t>(data[5]) << 24) | (static_cast<uint64_t>(data[6]) << 16)
+                        | (static_cast<uint64_t>(data[7]) << 8) | data[8];
+                sum += hi + lo;
+            }
+            sum %= 37;
+            size -= num_groups * 9;
+        }
+        for (; size; ++data, --size) {
+            sum = (sum * 256 + *data) % 37;
+        }
+        m_remainder = static_cast<uint32_t>(sum);
+    }
+
+    uint32_t value() const noexcept { return m_remainder; }
+
+private:
+    uint32_t m_remainder = 0;
+};
+
+// Data symbols are encoded and decoded by plain base32_crockford, followed by the check symbol.
+// The check symbol is computed in the same pass as encoding or decoding. Functions that encode
+// or decode a string in pieces, like encode_gather() or decode_gather(), would skip the check
+// symbol and are deleted. Without decode_partial(), codec::decode_range() doesn't compile either.
+template <typename Codec, typename CodecVariant>
+class crockford_check_codec
+    : public stream_codec<base32<base32_crockford>, base32_crockford>
+{
+    using base = stream_codec<base32<base32_crockford>, base32_crockford>;
+
+public:
+    template <typename Result, typename ResultState> static void encode(
+            Result& encoded_result, ResultState& state, const uint8_t* binary, size_t binary_size)
+    {
+        // Small enough that the checksum leaves each chunk in L1 cache for the encoder to read.
+        constexpr const size_t chunk_size = Codec::binary_block_size() * 1024;
+
+        crockford_checksum checksum;
+        size_t num_symbols = 0;
+        for (; binary_size > chunk_size; binary += chunk_size, binary_size -= chunk_size) {
+            checksum.update(binary, chunk_size);
+            base::encode_continued(encoded_result, state, binary, chunk_size, num_symbols);
+        }
+        checksum.update(binary, binary_size);
+        base::encode_continued(encoded_result, state, binary, binary_size, num_symbols);
+
+        data::put(encoded_result, state,
+                CodecVariant::symbol(static_cast<alphabet_index_t>(checksum.value())));
+    }
+
+    template <size_t BinarySize, typename Result, typename ResultState>
+    static void encode_unrolled(Result& encoded_result, ResultState& state, const uint8_t* binary)
+    {
+        encode(encoded_result, state, binary, BinarySize);
+    }
+
+    template <typename Result, typename ResultState> static void decode(
+            Result& binary_result, ResultState& state, const char* encoded, size_t encoded_size)
+    {
+        using info = alphabet_index_info<CodecVariant>;
+
+        size_t data_size = check_symbol_position(encoded, encoded_size);
+        if (data_size == encoded_size) {
+            throw checksum_error();
+        }
+        alphabet_index_t check = info::lookup::for_symbol(encoded[data_size]);
+        if (info::is_stop_character(check)) {
+            throw symbol_error(encoded[data_size], data_size);
+        }
+
+        crockford_checksum checksum;
+        data::checksum_result_buffer<crockford_checksum, Result, ResultState> window(
+                checksum, binary_result, state);
+        auto window_state = data::create_state(window, data::specific_t());
+        base::decode(window, window_state, encoded, data_size);
+        window.flush();
+
+        if (check != checksum.value()) {
+            throw checksum_error();
+        }
+    }
+
+    static bool validate(const char* encoded, size_t encoded_size) noexcept
+    {
+        using info = alphabet_index_info<CodecVariant>;
+
+        size_t data_size = check_symbol_position(encoded, encoded_size);
+        if (data_size == encoded_size || !base::validate(encoded, data_size)) {
+            return false;
+        }
+        alphabet_index_t check = info::lookup::for_symbol(encoded[data_size]);
+        if (info::is_stop_character(check)) {
+            return false;
+        }
+
+        // The data symbols are valid, so decoding them only computes the checksum and can't throw.
+        crockford_checksum checksum;
+        data::null_result_buffer null_result;
+        auto null_state = data::create_state(null_result, data::specific_t());
+        data::checksum_result_buffer<crockford_checksum, data::null_result_buffer, decltype(null_state)>
+                window(checksum, null_result, null_state);
+        auto window_state = data::create_state(window, data::specific_t());
+        base::decode(window, window_state, encoded, data_size);
+        window.flush();
+        return check == checksum.value();
+    }
+
+    static constexpr size_t encoded_size(size_t binary_size) noexcept
+    {
+        return base::encoded_size(binary_size) + 1;
+    }
+
+    static size_t decoded_size(const char* encoded, size_t encoded_size) noexcept
+    {
+        return base::decoded_size(encoded, check_symbol_position(encoded, encoded_size));
+    }
+
+    template <typename Result, typename ResultState> static void encode_continued(
+            Result&, ResultState&, const uint8_t*, size_t, size_t&) = delete;
+    template <typename Result, typename ResultState> static void decode_partial(
+            Result&, ResultState&, resumable_decode_state&, const char*, size_t) = delete;
+    template <typename Result, typename ResultState> static void decode_finish(
+            Result&, ResultState&, resumable_decode_state&) = delete;
+    template <size_t NumLanes> static uint_fast32_t decode_lanes(
+            uint8_t*, size_t, const char*, size_t) noexcept = delete;
+    static size_t count_symbols(const char*, size_t, size_t&) noexcept = delete;
+    static size_t skip_symbols(const char*, size_t, size_t) noexcept = delete;
+
+private:
+    // Returns the position of the check symbol, i.e. the last one before any trailing hyphens
+    // and end-of-input symbols, or encoded_size if there are no symbols at all.
+    static size_t check_symbol_position(const char* encoded, size_t encoded_size) noexcept
+    {
+        size_t end = encoded_size;
+        while (end && (CodecVariant::should_ignore(encoded[end - 1])
+                || CodecVariant::is_eof_symbol(encoded[end - 1]))) {
+            --end;
+        }
+        return end ? end - 1 : encoded_size;
+    }
+};
+
+} // namespace detail
+
+using base32_crockford_check = detail::codec<detail::base32<detail::base32_crockford_check>>;
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_BASE32_CROCKFORD_CHECK
@@ -0,0 +1,56 @@
+/**
+ *  Copyright (C) 2016 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_BASE64_MIME
+#define CPPCODEC_BASE64_MIME
+
+#include "base64_rfc4648.hpp"
+
+namespace cppcodec {
+
+namespace detail {
+
+// MIME (RFC 2045) uses the RFC 4648 alphabet and padding, but limits encoded lines to
+// 76 characters, i.e. 19 blocks. The encoder breaks lines with CRLF, the decoder skips
+// CR and LF anywhere in the input. Other whitespace is still a parse error.
+class base64_mime : public base64_rfc4648
+{
+public:
+    template <typename Codec> using codec_impl = stream_codec<Codec, base64_mime>;
+
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_length() { return 76; }
+    static CPPCODEC_ALWAYS_INLINE constexpr const char* line_break() { return "\r\n"; }
+
+    static CPPCODEC_ALWAYS_INLINE constexpr bool should_ignore(char c)
+    {
+        return c == '\r' || c == '\n';
+    }
+};
+
+} // namespace detail
+
+using base64_mime = detail::codec<detail::base64<detail::base64_mime>>;
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_BASE64_MIME
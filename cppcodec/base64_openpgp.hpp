@@ -0,0 +1,210 @@
+/**
+ *  Copyright (C) 2016 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_BASE64_OPENPGP
+#define CPPCODEC_BASE64_OPENPGP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base64_rfc4648.hpp"
+#include "crc24.hpp"
+#include "data/access.hpp"
+#include "data/checksum_result_buffer.hpp"
+#include "data/null_result_buffer.hpp"
+#include "parse_error.hpp"
+
+namespace cppcodec {
+
+namespace detail {
+
+template <typename Codec, typename CodecVariant> class openpgp_armor_codec;
+
+// OpenPGP ASCII armor (RFC 4880) uses the RFC 4648 alphabet and padding with lines of
+// 64 characters, like GnuPG. The encoded data is followed by a line with the CRC-24 of the
+// binary data: "=" and four more base64 symbols. The decoder skips CR, LF, spaces and tabs.
+class base64_openpgp : public base64_rfc4648
+{
+public:
+    template <typename Codec> using codec_impl = openpgp_armor_codec<Codec, base64_openpgp>;
+
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_length() { return 64; }
+    static CPPCODEC_ALWAYS_INLINE constexpr const char* line_break() { return "\n"; }
+
+    static CPPCODEC_ALWAYS_INLINE constexpr bool should_ignore(char c)
+    {
+        return c == '\r' || c == '\n' || c == ' ' || c == '\t';
+    }
+};
+
+// Same as stream_codec, plus the checksum line. Checksums are computed in the same pass as
+// encoding or decoding, one chunk of data at a time. Functions that encode or decode a string
+// in pieces, like encode_gather() or decode_gather(), would skip the checksum and are deleted.
+template <typename Codec, typename CodecVariant>
+class openpgp_armor_codec : public stream_codec<Codec, CodecVariant>
+{
+    using base = stream_codec<Codec, CodecVariant>;
+
+    // '=' and the encoded 3-byte CRC, preceded by a line break unless there is no data.
+    static constexpr const size_t checksum_line_size = 5;
+
+public:
+    template <typename Result, typename ResultState> static void encode(
+            Result& encoded_result, ResultState& state, const uint8_t* binary, size_t binary_size)
+    {
+        // Small enough that the checksum leaves each chunk in L1 cache for the encoder to read.
+        constexpr const size_t chunk_size = Codec::binary_block_size() * 1024;
+
+        crc24 checksum;
+        size_t num_symbols = 0;
+        for (; binary_size > chunk_size; binary += chunk_size, binary_size -= chunk_size) {
+            checksum.update(binary, chunk_size);
+            base::encode_continued(encoded_result, state, binary, chunk_size, num_symbols);
+        }
+        checksum.update(binary, binary_size);
+        base::encode_continued(encoded_result, state, binary, binary_size, num_symbols);
+
+        if (num_symbols) {
+            line_wrapping<CodecVariant>::put_line_break(encoded_result, state);
+        }
+        uint32_t crc = checksum.value();
+        const uint8_t crc_bytes[3] = {
+            static_cast<uint8_t>(crc >> 16), static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc) };
+        data::put(encoded_result, state, '=');
+        base::encode(encoded_result, state, crc_bytes, sizeof(crc_bytes));
+    }
+
+    template <size_t BinarySize, typename Result, typename ResultState>
+    static void encode_unrolled(Result& encoded_result, ResultState& state, const uint8_t* binary)
+    {
+        encode(encoded_result, state, binary, BinarySize);
+    }
+
+    template <typename Result, typename ResultState> static void decode(
+            Result& binary_result, ResultState& state, const char* encoded, size_t encoded_size)
+    {
+        size_t data_size = checksum_position(encoded, encoded_size);
+        if (data_size == encoded_size) {
+            throw checksum_error();
+        }
+
+        crc24 checksum;
+        data::checksum_result_buffer<crc24, Result, ResultState> window(checksum, binary_result, state);
+        auto window_state = data::create_state(window, data::specific_t());
+        base::decode(window, window_state, encoded, data_size);
+        window.flush();
+
+        if (checksum_line_value(encoded, data_size) != checksum.value()) {
+            throw checksum_error();
+        }
+    }
+
+    static bool validate(const char* encoded, size_t encoded_size) noexcept
+    {
+        size_t data_size = checksum_position(encoded, encoded_size);
+        if (data_size == encoded_size || !base::validate(encoded, data_size)) {
+            return false;
+        }
+
+        // The data is valid, so decoding it only computes the checksum and can't throw.
+        crc24 checksum;
+        data::null_result_buffer null_result;
+        auto null_state = data::create_state(null_result, data::specific_t());
+        data::checksum_result_buffer<crc24, data::null_result_buffer, decltype(null_state)>
+                window(checksum, null_result, null_state);
+        auto window_state = data::create_state(window, data::specific_t());
+        base::decode(window, window_state, encoded, data_size);
+        window.flush();
+        return checksum_line_value(encoded, data_size) == checksum.value();
+    }
+
+    static constexpr size_t encoded_size(size_t binary_size) noexcept
+    {
+        return base::encoded_size(binary_size) + checksum_line_size
+                + (binary_size ? string_length(CodecVariant::line_break()) : 0);
+    }
+
+    static size_t decoded_size(const char* encoded, size_t encoded_size) noexcept
+    {
+        return base::decoded_size(encoded, checksum_position(encoded, encoded_size));
+    }
+
+    template <typename Result, typename ResultState> static void encode_continued(
+            Result&, ResultState&, const uint8_t*, size_t, size_t&) = delete;
+    template <typename Result, typename ResultState> static void decode_partial(
+            Result&, ResultState&, resumable_decode_state&, const char*, size_t) = delete;
+    template <typename Result, typename ResultState> static void decode_finish(
+            Result&, ResultState&, resumable_decode_state&) = delete;
+    template <size_t NumLanes> static uint_fast32_t decode_lanes(
+            uint8_t*, size_t, const char*, size_t) noexcept = delete;
+    static size_t count_symbols(const char*, size_t, size_t&) noexcept = delete;
+    static size_t skip_symbols(const char*, size_t, size_t) noexcept = delete;
+
+private:
+    // The checksum line has no padding and no ignored characters, see checksum_position().
+    static uint32_t checksum_line_value(const char* encoded, size_t checksum_pos) noexcept
+    {
+        uint32_t crc = 0;
+        for (size_t i = checksum_pos + 1; i < checksum_pos + checksum_line_size; ++i) {
+            crc = (crc << 6) | static_cast<uint32_t>(
+                    alphabet_index_info<CodecVariant>::lookup::for_symbol(encoded[i]));
+        }
+        return crc;
+    }
+
+    // Returns the position of the checksum line's '=', which must be at the start of the
+    // last non-empty line and followed by exactly four symbols, or encoded_size if there is none.
+    // Trailing end-of-input symbols are skipped like line breaks, e.g. for string literals.
+    // Data lines can't start with '=', as line breaks only go between two blocks.
+    static size_t checksum_position(const char* encoded, size_t encoded_size) noexcept
+    {
+        using info = alphabet_index_info<CodecVariant>;
+
+        size_t end = encoded_size;
+        while (end && (CodecVariant::should_ignore(encoded[end - 1])
+                || CodecVariant::is_eof_symbol(encoded[end - 1]))) {
+            --end;
+        }
+        if (end < checksum_line_size) {
+            return encoded_size;
+        }
+        size_t pos = end - checksum_line_size;
+        if (encoded[pos] != '=' || (pos && encoded[pos - 1] != '\n')) {
+            return encoded_size;
+        }
+        for (size_t i = pos + 1; i < end; ++i) {
+            if (info::is_stop_character(info::lookup::for_symbol(encoded[i]))) {
+                return encoded_size;
+            }
+        }
+        return pos;
+    }
+};
+
+} // namespace detail
+
+using base64_openpgp = detail::codec<detail::base64<detail::base64_openpgp>>;
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_BASE64_OPENPGP
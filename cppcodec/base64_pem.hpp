@@ -0,0 +1,56 @@
+/**
+ *  Copyright (C) 2016 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_BASE64_PEM
+#define CPPCODEC_BASE64_PEM
+
+#include "base64_rfc4648.hpp"
+
+namespace cppcodec {
+
+namespace detail {
+
+// PEM (RFC 1421, RFC 7468) uses the RFC 4648 alphabet and padding, with encoded lines of
+// 64 characters, i.e. 16 blocks. The encoder breaks lines with LF. The decoder skips
+// CR, LF, spaces and tabs anywhere in the input, like RFC 7468's lax parsers do.
+class base64_pem : public base64_rfc4648
+{
+public:
+    template <typename Codec> using codec_impl = stream_codec<Codec, base64_pem>;
+
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_length() { return 64; }
+    static CPPCODEC_ALWAYS_INLINE constexpr const char* line_break() { return "\n"; }
+
+    static CPPCODEC_ALWAYS_INLINE constexpr bool should_ignore(char c)
+    {
+        return c == '\r' || c == '\n' || c == ' ' || c == '\t';
+    }
+};
+
+} // namespace detail
+
+using base64_pem = detail::codec<detail::base64<detail::base64_pem>>;
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_BASE64_PEM
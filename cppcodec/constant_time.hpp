@@ -0,0 +1,263 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_CONSTANT_TIME
+#define CPPCODEC_CONSTANT_TIME
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h> // for memcpy()
+#include <type_traits>
+
+#include "detail/codec.hpp"
+#include "detail/config.hpp"
+#include "detail/stream_codec.hpp"
+#include "parse_error.hpp"
+
+// Decoding without lookup tables, for secret data such as private keys or tokens.
+//
+// Regular decoding looks up each character in a 256-entry table, so which cache lines get loaded
+// depends on the secret. constant_time<Codec> derives alphabet indexes arithmetically instead,
+// with the same sequence of instructions and memory accesses for every valid symbol.
+// Branches and loop iterations still depend on the length of the input, padding,
+// ignored characters and invalid symbols, i.e. on the shape of the input but not on its content.
+
+namespace cppcodec {
+
+namespace detail {
+
+template <typename Codec, typename CodecVariant> class constant_time_stream_codec;
+
+// True if CodecVariant is implemented by a plain stream_codec, without a layer of its own on top.
+template <typename CodecVariant>
+struct uses_stream_codec : std::is_same<
+        typename CodecVariant::template codec_impl<void>, stream_codec<void, CodecVariant>> { };
+
+// A codec variant that behaves exactly like CodecVariant, except for symbol lookups.
+template <typename CodecVariant>
+class constant_time_variant : public CodecVariant
+{
+    // The codec implementation is replaced by constant_time_stream_codec, which would drop
+    // anything that the variant's own implementation adds, such as a checksum.
+    static_assert(uses_stream_codec<CodecVariant>::value,
+            "constant_time<> is not available for codecs with a checksum, such as base64_openpgp "
+            "or base32_crockford_check");
+
+public:
+    template <typename Codec> using codec_impl = constant_time_stream_codec<Codec, constant_time_variant>;
+};
+
+// The regular lookup table is turned into a list of runs, i.e. ranges of consecutive characters
+// that map to consecutive alphabet indexes (or to the same padding/eof index). Those are few:
+// base64 has "A-Z", "a-z", "0-9", "+", "/", "=" and the null terminator, for example.
+// All of this is evaluated at compile time.
+template <typename CodecVariant>
+struct constant_time_runs
+{
+    using info = alphabet_index_info<CodecVariant>;
+    static constexpr const size_t num_symbols = info::num_possible_symbols;
+
+    static constexpr alphabet_index_t at(size_t c)
+    {
+        return alphabet_index_table<CodecVariant>::table.lookup[c];
+    }
+    static constexpr bool continues_run(size_t c)
+    {
+        return c > 0 && at(c) != info::invalid_idx
+                && (info::is_stop_character(at(c)) ? at(c) == at(c - 1)
+                    : !info::is_stop_character(at(c - 1)) && at(c) == at(c - 1) + 1);
+    }
+    static constexpr bool starts_run(size_t c)
+    {
+        return at(c) != info::invalid_idx && !continues_run(c);
+    }
+    static constexpr size_t num_runs(size_t c = 0)
+    {
+        return c == num_symbols ? 0 : (starts_run(c) ? 1 : 0) + num_runs(c + 1);
+    }
+    static constexpr size_t run_start(size_t n, size_t c = 0)
+    {
+        return starts_run(c) ? (n == 0 ? c : run_start(n - 1, c + 1)) : run_start(n, c + 1);
+    }
+    static constexpr size_t run_length(size_t start, size_t length = 1)
+    {
+        return start + length < num_symbols && continues_run(start + length)
+                ? run_length(start, length + 1) : length;
+    }
+};
+
+template <typename CodecVariant, size_t NumRuns>
+struct constant_time_match
+{
+    using runs = constant_time_runs<CodecVariant>;
+    static constexpr const uint32_t start = runs::run_start(NumRuns - 1);
+    static constexpr const uint32_t length = runs::run_length(start);
+    static constexpr const uint32_t first_idx = runs::at(start);
+    static constexpr const uint32_t step = runs::info::is_stop_character(first_idx) ? 0 : 1;
+
+    static CPPCODEC_ALWAYS_INLINE void match(uint32_t c, uint32_t& idx, uint32_t& matched)
+    {
+        // d wraps around if c < start, and length - 1 - d does if c >= start + length.
+        // Either way, the top bit is set, so mask is all ones only if c is within this run.
+        // Single characters need just one subtraction: (c ^ start) - 1 wraps only if c == start.
+        uint32_t d = c - start;
+        uint32_t mask = (length == 1) ? 0u - (((c ^ start) - 1) >> 31) : ((d | (length - 1 - d)) >> 31) - 1;
+        idx |= mask & (step ? first_idx + d : first_idx);
+        matched |= mask;
+        constant_time_match<CodecVariant, NumRuns - 1>::match(c, idx, matched);
+    }
+};
+template <typename CodecVariant>
+struct constant_time_match<CodecVariant, 0> // terminating specialization
+{
+    static CPPCODEC_ALWAYS_INLINE void match(uint32_t, uint32_t&, uint32_t&) { }
+};
+
+// The same matching for eight characters at once, one per byte of a uint64_t (SIMD within a register).
+// Only valid symbols are matched, so this requires all of them to be 7-bit characters.
+// Setting bit 7 of each byte before subtracting, and looking only at bit 7 after adding,
+// keeps carries and borrows from crossing into the neighbouring byte.
+template <typename CodecVariant, size_t NumRuns>
+struct constant_time_swar_match
+{
+    using run = constant_time_match<CodecVariant, NumRuns>;
+    static constexpr const uint64_t ones = 0x0101010101010101ull;
+    static constexpr const uint64_t high_bits = 0x8080808080808080ull;
+    static constexpr const uint64_t low_bits = 0x7F7F7F7F7F7F7F7Full;
+
+    static constexpr bool fits() // i.e. all valid symbols are 7-bit
+    {
+        return (!run::step || run::start + run::length <= 128)
+                && constant_time_swar_match<CodecVariant, NumRuns - 1>::fits();
+    }
+
+    static CPPCODEC_ALWAYS_INLINE void match(uint64_t c, uint64_t& idx, uint64_t& matched)
+    {
+        if (run::step) { // Stop characters (padding, eof) never make it into a full group.
+            uint64_t at_or_above_start = c + (128 - (run::start & 0x7F)) * ones;
+            uint64_t at_or_above_end = c + ((128 - ((run::start + run::length) & 0xFF)) & 0xFF) * ones;
+            uint64_t in_run = at_or_above_start & ~at_or_above_end & high_bits;
+            uint64_t mask = (in_run >> 7) * 0xFF;
+            idx |= mask & ((((c | high_bits) - (run::start & 0x7F) * ones) & low_bits)
+                    + (run::first_idx & 0x7F) * ones);
+            matched |= in_run;
+        }
+        constant_time_swar_match<CodecVariant, NumRuns - 1>::match(c, idx, matched);
+    }
+};
+template <typename CodecVariant>
+struct constant_time_swar_match<CodecVariant, 0> // terminating specialization
+{
+    static constexpr bool fits() { return true; }
+    static CPPCODEC_ALWAYS_INLINE void match(uint64_t, uint64_t&, uint64_t&) { }
+};
+
+// Same as the regular alphabet_index_info, but with an arithmetic lookup.
+template <typename CodecVariant>
+struct alphabet_index_info<constant_time_variant<CodecVariant>> : alphabet_index_info<CodecVariant>
+{
+    struct lookup {
+        static CPPCODEC_ALWAYS_INLINE alphabet_index_t for_symbol(char symbol)
+        {
+            using runs = constant_time_runs<CodecVariant>;
+            uint32_t idx = 0;
+            uint32_t matched = 0;
+            constant_time_match<CodecVariant, runs::num_runs()>::match(
+                    static_cast<uint8_t>(symbol), idx, matched);
+            return static_cast<alphabet_index_t>(idx | (runs::info::invalid_idx & ~matched));
+        }
+    };
+};
+
+// Same as stream_codec, but decodes groups of eight valid symbols at a time when it can.
+// Those take a fraction of the instructions that eight separate for_symbol() lookups would.
+// Anything else (ignored characters, padding, invalid symbols, the last few characters)
+// is left to stream_codec::decode(), which uses for_symbol().
+template <typename Codec, typename CodecVariant>
+class constant_time_stream_codec<Codec, constant_time_variant<CodecVariant>>
+    : public stream_codec<Codec, constant_time_variant<CodecVariant>>
+{
+    using base = stream_codec<Codec, constant_time_variant<CodecVariant>>;
+    using runs = constant_time_runs<CodecVariant>;
+    using swar = constant_time_swar_match<CodecVariant, runs::num_runs()>;
+
+public:
+    template <typename Result, typename ResultState> static void decode(
+            Result& binary_result, ResultState& state, const char* encoded, size_t encoded_size)
+    {
+        size_t pos = 0;
+        if (swar::fits() && 8 % Codec::encoded_block_size() == 0) {
+            pos = decode_groups(binary_result, state, encoded, encoded_size);
+        }
+        try {
+            base::decode(binary_result, state, encoded + pos, encoded_size - pos);
+        } catch (const symbol_error& e) {
+            throw symbol_error(e.symbol(), pos + e.offset());
+        }
+    }
+
+private:
+    template <typename Result, typename ResultState> static size_t decode_groups(
+            Result& binary_result, ResultState& state, const char* encoded, size_t encoded_size)
+    {
+        size_t pos = 0;
+        for (; encoded_size - pos >= 8; pos += 8) {
+            uint64_t c;
+            memcpy(&c, encoded + pos, 8);
+            uint64_t idx = 0;
+            uint64_t matched = 0;
+            swar::match(c & swar::low_bits, idx, matched);
+            if ((matched & ~c) != swar::high_bits) {
+                break; // not eight valid 7-bit symbols
+            }
+            // Byte order doesn't matter here, each byte went through the same arithmetic.
+            uint8_t bytes[8];
+            memcpy(bytes, &idx, 8);
+            alphabet_index_t indexes[8];
+            for (size_t i = 0; i < 8; ++i) {
+                indexes[i] = bytes[i];
+            }
+            for (size_t i = 0; i < 8; i += Codec::encoded_block_size()) {
+                Codec::decode_block(binary_result, state, indexes + i);
+            }
+        }
+        return pos;
+    }
+};
+
+template <typename Codec> struct constant_time_codec;
+template <template <typename> class CodecImpl, typename CodecVariant>
+struct constant_time_codec<codec<CodecImpl<CodecVariant>>>
+{
+    using type = codec<CodecImpl<constant_time_variant<CodecVariant>>>;
+};
+
+} // namespace detail
+
+// The same codec as Codec, e.g. constant_time<base64_rfc4648>, but decoding in constant time.
+template <typename Codec>
+using constant_time = typename detail::constant_time_codec<Codec>::type;
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_CONSTANT_TIME
@@ -0,0 +1,91 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_CRC24
+#define CPPCODEC_CRC24
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cppcodec {
+
+namespace detail {
+
+// Lookup tables for slicing by 4, i.e. one table per byte of a 32-bit word. The 24-bit CRC is
+// kept in the upper 24 bits of a uint32_t, so that the regular MSB-first algorithm applies.
+inline const uint32_t (*crc24_tables())[256]
+{
+    struct tables_t {
+        uint32_t entries[4][256];
+        tables_t() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i << 24;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc << 1) ^ (0x864CFB00u & (0u - (crc >> 31)));
+                }
+                entries[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int t = 1; t < 4; ++t) {
+                    uint32_t crc = entries[t - 1][i];
+                    entries[t][i] = (crc << 8) ^ entries[0][crc >> 24];
+                }
+            }
+        }
+    };
+    static const tables_t tables;
+    return tables.entries;
+}
+
+} // namespace detail
+
+// Streaming CRC-24 checksum as used by OpenPGP ASCII armor (RFC 4880), see base64_openpgp.
+class crc24
+{
+public:
+    void update(const uint8_t* data, size_t size) noexcept
+    {
+        const uint32_t (*tables)[256] = detail::crc24_tables();
+        uint32_t crc = m_crc;
+        for (; size >= 4; data += 4, size -= 4) {
+            crc ^= (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16)
+                    | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+            crc = tables[3][crc >> 24] ^ tables[2][(crc >> 16) & 0xFF]
+                    ^ tables[1][(crc >> 8) & 0xFF] ^ tables[0][crc & 0xFF];
+        }
+        for (; size; ++data, --size) {
+            crc = (crc << 8) ^ tables[0][(crc >> 24) ^ *data];
+        }
+        m_crc = crc;
+    }
+
+    uint32_t value() const noexcept { return m_crc >> 8; }
+    void reset() noexcept { m_crc = 0xB704CEu << 8; }
+
+private:
+    uint32_t m_crc = 0xB704CEu << 8;
+};
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_CRC24
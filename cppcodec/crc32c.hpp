@@ -0,0 +1,104 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_CRC32C
+#define CPPCODEC_CRC32C
+
+#include <stdint.h>
+#include <string.h> // for memcpy()
+
+#if defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#define CPPCODEC_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#endif
+
+namespace cppcodec {
+
+namespace detail {
+
+// Lookup table for the software fallback, Castagnoli polynomial in reversed bit order.
+inline const uint32_t* crc32c_table()
+{
+    struct table_t {
+        uint32_t entries[256];
+        table_t() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1u)));
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+    static const table_t table;
+    return table.entries;
+}
+
+} // namespace detail
+
+// Streaming CRC-32C (Castagnoli) checksum, e.g. for encode_with_checksum().
+// Uses the SSE 4.2 crc32 instruction if the compiler targets it (e.g. -msse4.2 or -march=native),
+// and a lookup table otherwise.
+class crc32c
+{
+public:
+    void update(const uint8_t* data, size_t size) noexcept
+    {
+        uint32_t crc = m_crc;
+#ifdef CPPCODEC_CRC32C_SSE42
+#if defined(__x86_64__) || defined(_M_X64)
+        for (; size >= 8; data += 8, size -= 8) {
+            uint64_t word;
+            memcpy(&word, data, sizeof(word));
+            crc = static_cast<uint32_t>(_mm_crc32_u64(crc, word));
+        }
+#else
+        for (; size >= 4; data += 4, size -= 4) {
+            uint32_t word;
+            memcpy(&word, data, sizeof(word));
+            crc = _mm_crc32_u32(crc, word);
+        }
+#endif
+        for (; size; ++data, --size) {
+            crc = _mm_crc32_u8(crc, *data);
+        }
+#else
+        const uint32_t* table = detail::crc32c_table();
+        for (; size; ++data, --size) {
+            crc = table[(crc ^ *data) & 0xFF] ^ (crc >> 8);
+        }
+#endif
+        m_crc = crc;
+    }
+
+    uint32_t value() const noexcept { return ~m_crc; }
+    void reset() noexcept { m_crc = ~0u; }
+
+private:
+    uint32_t m_crc = ~0u;
+};
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_CRC32C
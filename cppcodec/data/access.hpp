@@ -25,7 +25,9 @@
 #ifndef CPPCODEC_DETAIL_DATA_ACCESS
 #define CPPCODEC_DETAIL_DATA_ACCESS
 
+#include <array> // for std::array result support
 #include <stdint.h> // for size_t
+#include <stdlib.h> // for abort()
 #include <string> // for static_assert() checking that string will be optimized
 #include <type_traits> // for std::enable_if, std::remove_reference, and such
 #include <utility> // for std::declval
@@ -41,11 +43,12 @@ namespace data {
 // the default type requirements:
 // For result types: init(Result&, ResultState&, size_t capacity),
 //     put(Result&, ResultState&, char), finish(Result&, State&)
+//     and optionally init_append(Result&, ResultState&, size_t capacity) and resize(size_t)
 // For const (read-only) types: char_data(const T&)
 // For both const and result types: size(const T&)
 
 template <typename T>
-CPPCODEC_ALWAYS_INLINE size_t size(const T& t) { return t.size(); }
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t size(const T& t) { return t.size(); }
 
 template <typename T, size_t N>
 CPPCODEC_ALWAYS_INLINE constexpr size_t size(const T (&t)[N]) noexcept {
@@ -79,12 +82,38 @@ CPPCODEC_ALWAYS_INLINE void init(Result& result, empty_result_state&, size_t cap
     result.reserve(capacity);
 }
 
+// Like init(), but keeps the existing contents and prepares to write after them.
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE void init_append(Result& result, empty_result_state&, size_t capacity)
+{
+    result.reserve(result.size() + capacity);
+}
+
 template <typename Result>
 CPPCODEC_ALWAYS_INLINE void finish(Result&, empty_result_state&)
 {
     // Default is to push_back(), which already increases the size.
 }
 
+// Drops what was appended after the first size characters, e.g. after a parse error.
+// Result types without resize(), such as output iterator adapters, can't take back what was
+// written and are left as they are.
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE auto truncate(Result& result, size_t size, specific_t)
+        -> decltype(result.resize(size), void())
+{
+    result.resize(size);
+}
+
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE void truncate(Result&, size_t, general_t) { }
+
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE void truncate(Result& result, size_t size)
+{
+    truncate(result, size, specific_t());
+}
+
 // For the put() default implementation, we try calling push_back() with either uint8_t or char,
 // whichever compiles. Scary-fancy template magic from http://stackoverflow.com/a/1386390.
 namespace fallback {
@@ -145,7 +174,7 @@ template <typename Result>
 class direct_data_access_result_state
 {
 public:
-    CPPCODEC_ALWAYS_INLINE void init(Result& result, size_t capacity)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init(Result& result, size_t capacity)
     {
         // reserve() may not actually allocate the storage right away,
         // and it isn't guaranteed that it will be untouched upon the
@@ -161,22 +190,28 @@ public:
         // Conditional code paths are slow so we only do it once, at the start.
         m_buffer = result.data();
     }
-    CPPCODEC_ALWAYS_INLINE void put(Result&, char c)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init_append(Result& result, size_t capacity)
+    {
+        m_offset = result.size();
+        result.resize(m_offset + capacity);
+        m_buffer = result.data();
+    }
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(Result&, char c)
     {
         m_buffer[m_offset++] = c;
     }
-    CPPCODEC_ALWAYS_INLINE void finish(Result& result)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(Result& result)
     {
         result.resize(m_offset);
     }
-    CPPCODEC_ALWAYS_INLINE size_t size(const Result&)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t size(const Result&)
     {
         return m_offset;
     }
 private:
     // Make sure to get the mutable buffer decltype by using assignment.
     typename std::remove_reference<
-            decltype(std::declval<Result>().data()[size_t(0)] = 'x')>::type* m_buffer;
+            decltype(std::declval<Result>().data()[size_t(0)] = 'x')>::type* m_buffer = nullptr;
     size_t m_offset = 0;
 };
 
@@ -189,7 +224,8 @@ private:
 template <typename Result,
           typename = typename std::enable_if<
                   data_is_mutable(static_cast<Result*>(nullptr))>::type>
-CPPCODEC_ALWAYS_INLINE direct_data_access_result_state<Result> create_state(Result&, specific_t)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17
+direct_data_access_result_state<Result> create_state(Result&, specific_t)
 {
     return direct_data_access_result_state<Result>();
 }
@@ -201,19 +237,29 @@ static_assert(std::is_same<
 
 // Specialized init(), put() and finish() functions for direct_data_access_result_state.
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void init(Result& result, direct_data_access_result_state<Result>& state, size_t capacity)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init(
+        Result& result, direct_data_access_result_state<Result>& state, size_t capacity)
 {
     state.init(result, capacity);
 }
 
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void put(Result& result, direct_data_access_result_state<Result>& state, char c)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init_append(
+        Result& result, direct_data_access_result_state<Result>& state, size_t capacity)
+{
+    state.init_append(result, capacity);
+}
+
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(
+        Result& result, direct_data_access_result_state<Result>& state, char c)
 {
     state.put(result, c);
 }
 
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void finish(Result& result, direct_data_access_result_state<Result>& state)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(
+        Result& result, direct_data_access_result_state<Result>& state)
 {
     state.finish(result);
 }
@@ -239,7 +285,7 @@ template <typename Result>
 class array_access_result_state
 {
 public:
-    CPPCODEC_ALWAYS_INLINE void init(Result& result, size_t capacity)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init(Result& result, size_t capacity)
     {
         // reserve() may not actually allocate the storage right away,
         // and it isn't guaranteed that it will be untouched upon the
@@ -247,15 +293,20 @@ public:
         // slightly reduce the size at the end if necessary.
         result.resize(capacity);
     }
-    CPPCODEC_ALWAYS_INLINE void put(Result& result, char c)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init_append(Result& result, size_t capacity)
+    {
+        m_offset = result.size();
+        result.resize(m_offset + capacity);
+    }
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(Result& result, char c)
     {
         result[m_offset++] = c;
     }
-    CPPCODEC_ALWAYS_INLINE void finish(Result& result)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(Result& result)
     {
         result.resize(m_offset);
     }
-    CPPCODEC_ALWAYS_INLINE size_t size(const Result&)
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t size(const Result&)
     {
         return m_offset;
     }
@@ -271,7 +322,8 @@ template <typename Result,
           typename = typename std::enable_if<
                   !data_is_mutable(static_cast<Result*>(nullptr)) // no more than one template option
                   && array_access_is_mutable(static_cast<Result*>(nullptr))>::type>
-CPPCODEC_ALWAYS_INLINE array_access_result_state<Result> create_state(Result&, specific_t)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17
+array_access_result_state<Result> create_state(Result&, specific_t)
 {
     return array_access_result_state<Result>();
 }
@@ -290,19 +342,88 @@ static_assert(std::is_same<
 
 // Specialized init(), put() and finish() functions for array_access_result_state.
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void init(Result& result, array_access_result_state<Result>& state, size_t capacity)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init(
+        Result& result, array_access_result_state<Result>& state, size_t capacity)
 {
     state.init(result, capacity);
 }
 
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void put(Result& result, array_access_result_state<Result>& state, char c)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init_append(
+        Result& result, array_access_result_state<Result>& state, size_t capacity)
+{
+    state.init_append(result, capacity);
+}
+
+template <typename Result>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(
+        Result& result, array_access_result_state<Result>& state, char c)
 {
     state.put(result, c);
 }
 
 template <typename Result>
-CPPCODEC_ALWAYS_INLINE void finish(Result& result, array_access_result_state<Result>& state)
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(
+        Result& result, array_access_result_state<Result>& state)
+{
+    state.finish(result);
+}
+
+//
+// Specialization for std::array, which can neither grow nor shrink.
+// The codec is expected to produce exactly as many elements as the array holds.
+// Like raw_result_buffer, this calls abort() instead of throwing if that isn't the case.
+// The capacity passed to init() is ignored, because decoding only knows an upper bound.
+//
+
+template <typename T, size_t N>
+class fixed_array_result_state
+{
+public:
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(std::array<T, N>& result, char c)
+    {
+        if (m_offset >= N) {
+            abort();
+        }
+        result[m_offset++] = static_cast<T>(c);
+    }
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(std::array<T, N>&)
+    {
+        if (m_offset != N) {
+            abort();
+        }
+    }
+    CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t size(const std::array<T, N>&)
+    {
+        return m_offset;
+    }
+private:
+    size_t m_offset = 0;
+};
+
+template <typename T, size_t N>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17
+fixed_array_result_state<T, N> create_state(std::array<T, N>&, specific_t)
+{
+    return fixed_array_result_state<T, N>();
+}
+
+template <typename T, size_t N>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void init(
+        std::array<T, N>&, fixed_array_result_state<T, N>&, size_t)
+{
+}
+
+template <typename T, size_t N>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put(
+        std::array<T, N>& result, fixed_array_result_state<T, N>& state, char c)
+{
+    state.put(result, c);
+}
+
+template <typename T, size_t N>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void finish(
+        std::array<T, N>& result, fixed_array_result_state<T, N>& state)
 {
     state.finish(result);
 }
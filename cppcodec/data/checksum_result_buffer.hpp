@@ -0,0 +1,75 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_DETAIL_CHECKSUM_RESULT_BUFFER
+#define CPPCODEC_DETAIL_CHECKSUM_RESULT_BUFFER
+
+#include <stdint.h> // for size_t
+
+#include "access.hpp"
+
+namespace cppcodec {
+namespace data {
+
+// Result type that passes output characters on to another result and keeps a copy of the last
+// ones in a small window. Whenever the window is full, the checksum is updated while the data
+// is still in L1 cache. That way, decoding with a checksum writes the output only once and
+// doesn't need to read it back from memory. Call flush() after the last character.
+template <typename Checksum, typename Result, typename ResultState>
+class checksum_result_buffer
+{
+public:
+    static constexpr const size_t window_size = 1024;
+
+    checksum_result_buffer(Checksum& checksum, Result& result, ResultState& state)
+        : m_checksum(checksum), m_result(result), m_state(state)
+    {
+    }
+
+    CPPCODEC_ALWAYS_INLINE void push_back(char c)
+    {
+        put(m_result, m_state, c);
+        m_window[m_size++] = static_cast<uint8_t>(c);
+        if (m_size == window_size) {
+            flush();
+        }
+    }
+
+    void flush()
+    {
+        m_checksum.update(m_window, m_size);
+        m_size = 0;
+    }
+
+private:
+    Checksum& m_checksum;
+    Result& m_result;
+    ResultState& m_state;
+    uint8_t m_window[window_size];
+    size_t m_size = 0;
+};
+
+} // namespace data
+} // namespace cppcodec
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+
+#ifndef CPPCODEC_DETAIL_NULL_RESULT_BUFFER
+#define CPPCODEC_DETAIL_NULL_RESULT_BUFFER
+
+#include <stdint.h> // for size_t
+
+#include "access.hpp"
+
+namespace cppcodec {
+namespace data {
+
+// Result type that only counts the number of output characters and discards them,
+// e.g. as the result behind a checksum_result_buffer when only the checksum is needed.
+class null_result_buffer
+{
+public:
+    CPPCODEC_ALWAYS_INLINE void push_back(char) { ++m_size; }
+    CPPCODEC_ALWAYS_INLINE size_t size() const { return m_size; }
+    CPPCODEC_ALWAYS_INLINE void resize(size_t size) { m_size = size; }
+
+private:
+    size_t m_size = 0;
+};
+
+template <> inline void init<null_result_buffer>(
+        null_result_buffer& result, empty_result_state&, size_t)
+{
+    result.resize(0);
+}
+template <> inline void finish<null_result_buffer>(null_result_buffer&, empty_result_state&) { }
+
+} // namespace data
+} // namespace cppcodec
+
+#endif
@@ -0,0 +1,139 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_DETAIL_SEGMENTED_RESULT_BUFFER
+#define CPPCODEC_DETAIL_SEGMENTED_RESULT_BUFFER
+
+#include <stdint.h> // for size_t
+#include <stdlib.h> // for abort()
+#include <utility> // for std::pair
+
+#include "access.hpp"
+
+namespace cppcodec {
+namespace data {
+
+// Result type that writes into a chain of fixed-size segments instead of one contiguous buffer,
+// e.g. the slots of a ring buffer or the pages of an std::deque. Segments are provided by a
+// SegmentSource with the following member functions:
+//
+//   std::pair<char*, size_t> next(); // Returns the next writable segment.
+//   void commit(size_t size);        // The next size bytes of the current segment are written.
+//
+// commit() is called before switching to the next segment and at the end of each encode/decode
+// call. If next() returns an empty segment, abort() is called, the same as for raw_result_buffer.
+//
+// With a block_size (usually the codec's encoded_block_size() for encoding, or its
+// binary_block_size() for decoding), segments are only switched between blocks, leaving the
+// rest of the previous segment unused. Blocks are split only if a segment is smaller than that.
+template <typename SegmentSource>
+class segmented_result_buffer
+{
+public:
+    explicit segmented_result_buffer(SegmentSource& source, size_t block_size = 1)
+        : m_source(source)
+        , m_block_size(block_size ? block_size : 1)
+    {
+    }
+
+    CPPCODEC_ALWAYS_INLINE void push_back(char c)
+    {
+        if (m_ptr == m_limit) {
+            next_segment();
+        }
+        *m_ptr = c;
+        ++m_ptr;
+        ++m_size;
+    }
+    CPPCODEC_ALWAYS_INLINE size_t size() const { return m_size; }
+
+    // Starts a new output after the data that was written so far.
+    void restart()
+    {
+        m_size = 0;
+        set_limit(false);
+    }
+
+    // Hands the data written since the last commit over to the segment source.
+    void commit()
+    {
+        if (m_ptr != m_committed) {
+            m_source.commit(static_cast<size_t>(m_ptr - m_committed));
+            m_committed = m_ptr;
+        }
+    }
+
+private:
+    void next_segment()
+    {
+        commit();
+        std::pair<char*, size_t> segment = m_source.next();
+        if (!segment.first || !segment.second) {
+            abort();
+        }
+        m_ptr = m_committed = segment.first;
+        m_end = segment.first + segment.second;
+        set_limit(true);
+    }
+
+    // Stop writing to the current segment at the last block boundary that fits.
+    // Segments smaller than a block are filled up entirely, blocks can't stay in one piece anyway.
+    void set_limit(bool is_new_segment)
+    {
+        size_t space = static_cast<size_t>(m_end - m_ptr);
+        size_t to_boundary = (m_block_size - m_size % m_block_size) % m_block_size;
+        if ((is_new_segment && space < m_block_size) || to_boundary > space) {
+            m_limit = m_end;
+            return;
+        }
+        m_limit = m_ptr + to_boundary + (space - to_boundary) / m_block_size * m_block_size;
+    }
+
+    SegmentSource& m_source;
+    size_t m_block_size;
+    size_t m_size = 0;
+    char* m_ptr = nullptr;
+    char* m_committed = nullptr;
+    char* m_limit = nullptr;
+    char* m_end = nullptr;
+};
+
+template <typename SegmentSource> inline void init(
+        segmented_result_buffer<SegmentSource>& result, empty_result_state&, size_t)
+{
+    result.restart();
+}
+template <typename SegmentSource> inline void init_append(
+        segmented_result_buffer<SegmentSource>&, empty_result_state&, size_t)
+{
+}
+template <typename SegmentSource> inline void finish(
+        segmented_result_buffer<SegmentSource>& result, empty_result_state&)
+{
+    result.commit();
+}
+
+} // namespace data
+} // namespace cppcodec
+
+#endif
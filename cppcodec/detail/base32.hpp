@@ -98,11 +98,11 @@ public:
     }
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_block(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_block(
             Result& decoded, ResultState&, const alphabet_index_t* idx);
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_tail(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_tail(
             Result& decoded, ResultState&, const alphabet_index_t* idx, size_t idx_len);
 };
 
@@ -113,7 +113,7 @@ public:
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void base32<CodecVariant>::decode_block(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void base32<CodecVariant>::decode_block(
         Result& decoded, ResultState& state, const alphabet_index_t* idx)
 {
     put(decoded, state, static_cast<uint8_t>(((idx[0] << 3) & 0xF8) | ((idx[1] >> 2) & 0x7)));
@@ -125,7 +125,7 @@ CPPCODEC_ALWAYS_INLINE void base32<CodecVariant>::decode_block(
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void base32<CodecVariant>::decode_tail(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void base32<CodecVariant>::decode_tail(
         Result& decoded, ResultState& state, const alphabet_index_t* idx, size_t idx_len)
 {
     if (idx_len == 1) {
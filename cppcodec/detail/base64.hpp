@@ -86,18 +86,18 @@ public:
     }
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_block(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_block(
             Result& decoded, ResultState&, const alphabet_index_t* idx);
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_tail(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_tail(
             Result& decoded, ResultState&, const alphabet_index_t* idx, size_t idx_len);
 };
 
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void base64<CodecVariant>::decode_block(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void base64<CodecVariant>::decode_block(
         Result& decoded, ResultState& state, const alphabet_index_t* idx)
 {
     uint_fast32_t dec = (idx[0] << 18) | (idx[1] << 12) | (idx[2] << 6) | idx[3];
@@ -108,7 +108,7 @@ CPPCODEC_ALWAYS_INLINE void base64<CodecVariant>::decode_block(
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void base64<CodecVariant>::decode_tail(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void base64<CodecVariant>::decode_tail(
         Result& decoded, ResultState& state, const alphabet_index_t* idx, size_t idx_len)
 {
     if (idx_len == 1) {
@@ -24,13 +24,22 @@
 #ifndef CPPCODEC_DETAIL_CODEC
 #define CPPCODEC_DETAIL_CODEC
 
+#include <algorithm>
+#include <array>
 #include <assert.h>
+#include <limits>
+#include <stdexcept>
 #include <stdint.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "../data/access.hpp"
 #include "../data/raw_result_buffer.hpp"
+#include "../data/segmented_result_buffer.hpp"
+#include "../fixed_string.hpp"
+#include "../parse_error.hpp"
+#include "stream_codec.hpp" // for resumable_decode_state
 
 namespace cppcodec {
 namespace detail {
@@ -39,6 +48,109 @@ namespace detail {
 template <typename T>
 struct non_numeric : std::enable_if<!std::is_arithmetic<T>::value> { };
 
+// SFINAE: Codecs with a checksum over all of the data, such as base64_openpgp, delete
+// decode_partial() and the other functions that only look at a part of the encoded string.
+template <typename CodecImpl>
+struct decodes_in_pieces
+{
+    template <typename C> static auto test(int) -> decltype(C::decode_partial(
+            std::declval<std::vector<uint8_t>&>(), std::declval<data::empty_result_state&>(),
+            std::declval<resumable_decode_state&>(), static_cast<const char*>(nullptr), size_t()),
+            std::true_type());
+    template <typename C> static std::false_type test(...);
+
+    static constexpr const bool value = decltype(test<CodecImpl>(0))::value;
+};
+
+// Segment access for encode_gather() and decode_gather(). A segment can be a (pointer, length)
+// std::pair, a struct iovec or similar with iov_base/iov_len members, or a container like std::string.
+template <typename T>
+inline const uint8_t* segment_data(const std::pair<T*, size_t>& segment) noexcept
+{
+    return static_cast<const uint8_t*>(static_cast<const void*>(segment.first));
+}
+template <typename T>
+inline size_t segment_size(const std::pair<T*, size_t>& segment) noexcept { return segment.second; }
+
+template <typename T>
+inline auto segment_data(const T& segment) noexcept -> decltype(segment.iov_base, (const uint8_t*)nullptr)
+{
+    return static_cast<const uint8_t*>(segment.iov_base);
+}
+template <typename T>
+inline auto segment_size(const T& segment) noexcept -> decltype(segment.iov_len, size_t())
+{
+    return segment.iov_len;
+}
+
+template <typename T>
+inline auto segment_data(const T& segment) -> decltype(segment.data(), (const uint8_t*)nullptr)
+{
+    return data::uchar_data(segment);
+}
+template <typename T>
+inline auto segment_size(const T& segment) -> decltype(segment.size(), size_t())
+{
+    return data::size(segment);
+}
+
+// Result adapter for decode_range(): drops the first skip bytes, and everything after length more.
+template <typename Result, typename ResultState>
+class range_result
+{
+public:
+    range_result(Result& result, ResultState& state, size_t skip, size_t length)
+        : m_result(result), m_state(state), m_skip(skip), m_remaining(length)
+    {
+    }
+
+    CPPCODEC_ALWAYS_INLINE void push_back(char c)
+    {
+        if (m_skip) {
+            --m_skip;
+        } else if (m_remaining) {
+            --m_remaining;
+            data::put(m_result, m_state, c);
+        }
+    }
+    size_t remaining() const { return m_remaining; }
+
+private:
+    Result& m_result;
+    ResultState& m_state;
+    size_t m_skip;
+    size_t m_remaining;
+};
+
+// Result adapter for equals(): compares decoded bytes against the expected binary data
+// instead of storing them. The comparison itself doesn't branch on the data.
+class compare_result
+{
+public:
+    compare_result(const uint8_t* expected, size_t expected_size)
+        : m_expected(expected), m_expected_size(expected_size)
+    {
+    }
+
+    CPPCODEC_ALWAYS_INLINE void push_back(char c)
+    {
+        if (m_size < m_expected_size) {
+            m_diff |= static_cast<uint8_t>(m_expected[m_size] ^ static_cast<uint8_t>(c));
+        } else {
+            m_diff = 1;
+        }
+        ++m_size;
+    }
+    bool mismatch() const noexcept { return m_diff != 0; }
+    bool equal() const noexcept { return m_diff == 0 && m_size == m_expected_size; }
+
+private:
+    const uint8_t* m_expected;
+    size_t m_expected_size;
+    size_t m_size = 0;
+    uint8_t m_diff = 0;
+};
+
 
 /**
  * Public interface for all the codecs. For API documentation, see README.md.
@@ -63,12 +175,40 @@ public:
 
     // Reused result container version. Resizes encoded_result before writing to it.
     template <typename Result>
-    static void encode(Result& encoded_result, const uint8_t* binary, size_t binary_size);
+    static CPPCODEC_CONSTEXPR_CXX17 void encode(
+            Result& encoded_result, const uint8_t* binary, size_t binary_size);
     template <typename Result>
     static void encode(Result& encoded_result, const char* binary, size_t binary_size);
     template <typename Result, typename T, typename non_numeric<T>::type* = nullptr>
     static void encode(Result& encoded_result, const T& binary);
 
+    // Append version. Grows encoded_result by encoded_size(binary_size) and writes after its end.
+    template <typename Result>
+    static void encode_append(Result& encoded_result, const uint8_t* binary, size_t binary_size);
+    template <typename Result>
+    static void encode_append(Result& encoded_result, const char* binary, size_t binary_size);
+    template <typename Result, typename T>
+    static void encode_append(Result& encoded_result, const T& binary);
+
+    // Batch version. Encodes each binary in a container of binaries back-to-back into a single
+    // encoded_result. Encoding i ends up at [offsets[i], offsets[i + 1]), offsets has count + 1 entries.
+    // Throws std::length_error, without writing anything, if the total size doesn't fit into an offset.
+    template <typename Result, typename Offsets, typename Binaries>
+    static void encode_batch(Result& encoded_result, Offsets& offsets, const Binaries& binaries);
+
+    // Scatter-gather version. Encodes a sequence of segments as if they had been concatenated,
+    // without copying them together first.
+    template <typename Result, typename Segments>
+    static void encode_gather(Result& encoded_result, const Segments& segments);
+
+    // Single-pass version that also feeds the binary data to a streaming checksum or hash,
+    // such as cppcodec::crc32c, via checksum.update(const uint8_t* data, size_t size).
+    template <typename Result, typename Checksum>
+    static void encode_with_checksum(Result& encoded_result, Checksum& checksum,
+            const uint8_t* binary, size_t binary_size);
+    template <typename Result, typename Checksum, typename T>
+    static void encode_with_checksum(Result& encoded_result, Checksum& checksum, const T& binary);
+
     // Raw pointer output, assumes pre-allocated memory with size > encoded_size(binary_size).
     static size_t encode(
             char* encoded_result, size_t encoded_buffer_size,
@@ -81,9 +221,29 @@ public:
             char* encoded_result, size_t encoded_buffer_size,
             const T& binary) noexcept;
 
+    // Fixed-capacity version for binary input with a size known at compile time. Doesn't allocate.
+    template <size_t BinarySize>
+    using encoded_fixed_string = fixed_string<CodecImpl::encoded_size(BinarySize)>;
+
+    template <size_t BinarySize>
+    static encoded_fixed_string<BinarySize> encode_fixed(const uint8_t* binary);
+    template <size_t BinarySize>
+    static encoded_fixed_string<BinarySize> encode_fixed(const uint8_t (&binary)[BinarySize]);
+    template <size_t BinarySize>
+    static encoded_fixed_string<BinarySize> encode_fixed(const std::array<uint8_t, BinarySize>& binary);
+
+    // std::array version, usable in constant expressions (C++17 and later).
+    template <size_t BinarySize>
+    static CPPCODEC_CONSTEXPR_CXX17 std::array<char, CodecImpl::encoded_size(BinarySize)> encode_array(
+            const std::array<uint8_t, BinarySize>& binary);
+
     // Calculate the exact length of the encoded string based on binary size.
     static constexpr size_t encoded_size(size_t binary_size) noexcept;
 
+    // Each group of binary_block_size() bytes is encoded into encoded_block_size() symbols.
+    static constexpr size_t binary_block_size() noexcept;
+    static constexpr size_t encoded_block_size() noexcept;
+
     //
     // Decoding
 
@@ -98,10 +258,50 @@ public:
 
     // Reused result container version. Resizes binary_result before writing to it.
     template <typename Result>
-    static void decode(Result& binary_result, const char* encoded, size_t encoded_size);
+    static CPPCODEC_CONSTEXPR_CXX17 void decode(
+            Result& binary_result, const char* encoded, size_t encoded_size);
     template <typename Result, typename T, typename non_numeric<T>::type* = nullptr>
     static void decode(Result& binary_result, const T& encoded);
 
+    // Append version. Keeps the existing contents of binary_result and writes after its end.
+    // On a parse_error, binary_result is truncated to its original size if it has resize().
+    template <typename Result>
+    static void decode_append(Result& binary_result, const char* encoded, size_t encoded_size);
+    template <typename Result, typename T>
+    static void decode_append(Result& binary_result, const T& encoded);
+
+    // Batch version for num_tokens tokens of token_size characters each, stored back-to-back.
+    // Token i is decoded to binary_result at [i * binary_size, (i + 1) * binary_size).
+    // Instead of throwing, valid[i] is set to false (and its bytes to zero) if token i doesn't
+    // decode to exactly binary_size bytes. Result can be any type supported by decode().
+    template <typename Result, typename Valid>
+    static void decode_batch(Result& binary_result, Valid& valid, size_t binary_size,
+            const char* encoded, size_t token_size, size_t num_tokens);
+
+    // Scatter-gather version. Decodes a sequence of segments as if they had been concatenated,
+    // without copying them together first.
+    template <typename Result, typename Segments>
+    static void decode_gather(Result& binary_result, const Segments& segments);
+
+    // Random access version for encoded strings without ignored characters such as line breaks.
+    // Decodes only the blocks that hold bytes [offset, offset + length) of the decoded data,
+    // and writes just those bytes to binary_result.
+    template <typename Result>
+    static void decode_range(Result& binary_result, const char* encoded, size_t encoded_size,
+            size_t offset, size_t length);
+    template <typename Result, typename T>
+    static void decode_range(Result& binary_result, const T& encoded, size_t offset, size_t length);
+
+    // Random access version for encoded strings with ignored characters, e.g. line-wrapped files.
+    // The seek index must have been built from the same encoded string.
+    class seek_index;
+    template <typename Result>
+    static void decode_range(Result& binary_result, const seek_index& index,
+            const char* encoded, size_t encoded_size, size_t offset, size_t length);
+    template <typename Result, typename T>
+    static void decode_range(Result& binary_result, const seek_index& index,
+            const T& encoded, size_t offset, size_t length);
+
     // Raw pointer output, assumes pre-allocated memory with size > decoded_max_size(encoded_size).
     static size_t decode(
             uint8_t* binary_result, size_t binary_buffer_size,
@@ -114,8 +314,101 @@ public:
     template<typename T> static size_t decode(
             char* binary_result, size_t binary_buffer_size, const T& encoded);
 
+    // Fixed-capacity version for encoded input with a size known at compile time. Doesn't allocate.
+    template <size_t EncodedSize>
+    using decoded_fixed_bytes = fixed_bytes<CodecImpl::decoded_max_size(EncodedSize)>;
+
+    // String literal version: the terminating '\0' doesn't count towards the encoded size.
+    template <size_t N>
+    static decoded_fixed_bytes<N - 1> decode_fixed(const char (&encoded)[N]);
+    template <size_t EncodedSize>
+    static decoded_fixed_bytes<EncodedSize> decode_fixed(const std::array<char, EncodedSize>& encoded);
+
+    // std::array version, usable in constant expressions (C++17 and later).
+    // Throws invalid_input_length if the encoded string doesn't decode to exactly BinarySize bytes.
+    template <size_t BinarySize>
+    static CPPCODEC_CONSTEXPR_CXX17 std::array<uint8_t, BinarySize> decode_array(
+            const char* encoded, size_t encoded_size);
+
     // Calculate the maximum size of the decoded binary buffer based on the encoded string length.
     static constexpr size_t decoded_max_size(size_t encoded_size) noexcept;
+
+    // Calculate the exact size of the decoded binary buffer by inspecting the encoded string.
+    static CPPCODEC_CONSTEXPR_CXX17 size_t decoded_size(const char* encoded, size_t encoded_size) noexcept;
+    template<typename T> static size_t decoded_size(const T& encoded) noexcept;
+
+    // Check whether an encoded string decodes to the given binary data, without decoding it into
+    // a buffer. Returns false at the first block that differs, or if decode() would throw.
+    static bool equals(const char* encoded, size_t encoded_size,
+            const uint8_t* binary, size_t binary_size) noexcept;
+    template<typename E, typename B> static bool equals(const E& encoded, const B& binary) noexcept;
+
+    // Same as equals(), but compares all of the data instead of stopping at the first difference,
+    // so the time taken doesn't reveal how much of a secret value was guessed correctly.
+    static bool equals_constant_time(const char* encoded, size_t encoded_size,
+            const uint8_t* binary, size_t binary_size) noexcept;
+    template<typename E, typename B>
+    static bool equals_constant_time(const E& encoded, const B& binary) noexcept;
+
+    // Check whether decode() would succeed, without producing any decoded output.
+    static bool validate(const char* encoded, size_t encoded_size) noexcept;
+    template<typename T> static bool validate(const T& encoded) noexcept;
+
+    // Resumable decoder for input that arrives in pieces, e.g. from a non-blocking socket.
+    class decoder;
+
+private:
+    template <typename Result>
+    static void decode_blocks(Result& binary_result, const char* encoded,
+            size_t encoded_begin, size_t encoded_end, size_t skip, size_t length);
+};
+
+template <typename CodecImpl>
+class codec<CodecImpl>::decoder
+{
+public:
+    // Appends the decoded bytes of all blocks that are complete so far to binary_result.
+    // The rest of the input is kept until the next decode() or finish() call.
+    template <typename Result>
+    void decode(Result& binary_result, const char* encoded, size_t encoded_size);
+    template <typename Result, typename T>
+    void decode(Result& binary_result, const T& encoded);
+
+    // Appends the last (partial) block and checks padding. Afterwards, a new stream can be decoded,
+    // also if this throws a parse_error.
+    template <typename Result>
+    void finish(Result& binary_result);
+
+    // Discards any input that hasn't been decoded yet, e.g. after a parse error.
+    void reset() noexcept { m_state = resumable_decode_state(); }
+
+private:
+    resumable_decode_state m_state;
+};
+
+template <typename CodecImpl>
+class codec<CodecImpl>::seek_index
+{
+public:
+    struct entry
+    {
+        size_t encoded_offset; // position in the encoded string where a block starts
+        size_t binary_offset;  // position of that block in the decoded data
+    };
+
+    // Scans the encoded string once and records an entry every interval bytes of decoded data,
+    // rounded up to whole blocks.
+    seek_index(const char* encoded, size_t encoded_size, size_t interval = 64 * 1024);
+    template <typename T>
+    explicit seek_index(const T& encoded, size_t interval = 64 * 1024);
+
+    // Returns the last entry at or before binary_offset.
+    const entry& find(size_t binary_offset) const noexcept;
+    const std::vector<entry>& entries() const noexcept { return m_entries; }
+
+private:
+    std::vector<entry> m_entries;
+    size_t m_interval;
 };
 
 
@@ -163,7 +456,7 @@ inline Result codec<CodecImpl>::encode(const T& binary)
 
 template <typename CodecImpl>
 template <typename Result>
-inline void codec<CodecImpl>::encode(
+inline CPPCODEC_CONSTEXPR_CXX17 void codec<CodecImpl>::encode(
     Result& encoded_result, const uint8_t* binary, size_t binary_size)
 {
     // This overload is where we reserve buffer capacity and call into CodecImpl.
@@ -191,6 +484,153 @@ inline void codec<CodecImpl>::encode(Result& encoded_result, const T& binary)
     encode(encoded_result, data::uchar_data(binary), data::size(binary));
 }
 
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::encode_append(
+    Result& encoded_result, const uint8_t* binary, size_t binary_size)
+{
+    // Grow the result once, then write in place just like encode() does.
+    size_t encoded_buffer_size = encoded_size(binary_size);
+    size_t orig_size = data::size(encoded_result);
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init_append(encoded_result, state, encoded_buffer_size);
+
+    CodecImpl::encode(encoded_result, state, binary, binary_size);
+    data::finish(encoded_result, state);
+    assert(data::size(encoded_result) == orig_size + encoded_buffer_size);
+    (void) orig_size;
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::encode_append(
+    Result& encoded_result, const char* binary, size_t binary_size)
+{
+    encode_append(encoded_result, reinterpret_cast<const uint8_t*>(binary), binary_size);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename T>
+inline void codec<CodecImpl>::encode_append(Result& encoded_result, const T& binary)
+{
+    encode_append(encoded_result, data::uchar_data(binary), data::size(binary));
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Offsets, typename Binaries>
+inline void codec<CodecImpl>::encode_batch(
+    Result& encoded_result, Offsets& offsets, const Binaries& binaries)
+{
+    using offset_t = typename Offsets::value_type;
+
+    // Check the largest offset first, so that nothing is written if it doesn't fit into offset_t.
+    size_t encoded_buffer_size = 0;
+    for (const auto& binary : binaries) {
+        encoded_buffer_size += encoded_size(data::size(binary));
+    }
+    if (static_cast<uintmax_t>(encoded_buffer_size)
+            > static_cast<uintmax_t>((std::numeric_limits<offset_t>::max)())) {
+        throw std::length_error("encoded batch size exceeds the range of the offset type");
+    }
+
+    // Compute all offsets in one pass, so the result is sized (and initialized) only once.
+    offsets.resize(data::size(binaries) + 1);
+    encoded_buffer_size = 0;
+    size_t i = 0;
+    for (const auto& binary : binaries) {
+        offsets[i++] = static_cast<offset_t>(encoded_buffer_size);
+        encoded_buffer_size += encoded_size(data::size(binary));
+    }
+    offsets[i] = static_cast<offset_t>(encoded_buffer_size);
+
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_buffer_size);
+
+    for (const auto& binary : binaries) {
+        CodecImpl::encode(encoded_result, state, data::uchar_data(binary), data::size(binary));
+    }
+    data::finish(encoded_result, state);
+    assert(data::size(encoded_result) == encoded_buffer_size);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Segments>
+inline void codec<CodecImpl>::encode_gather(Result& encoded_result, const Segments& segments)
+{
+    constexpr const size_t bbs = CodecImpl::binary_block_size();
+
+    size_t binary_size = 0;
+    for (const auto& segment : segments) {
+        binary_size += segment_size(segment);
+    }
+    size_t encoded_buffer_size = encoded_size(binary_size);
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_buffer_size);
+
+    // Blocks that straddle a segment boundary are collected in a carry buffer,
+    // everything else is encoded straight from the segment. With a single byte per block (hex),
+    // nothing is ever carried, but GCC's -Warray-bounds still sees a copy to carry + 1.
+    uint8_t carry[bbs > 1 ? bbs : 2];
+    size_t carry_size = 0;
+    size_t num_symbols = 0;
+    for (const auto& segment : segments) {
+        const uint8_t* binary = segment_data(segment);
+        size_t size = segment_size(segment);
+
+        if (carry_size) {
+            size_t num_copied = std::min(bbs - carry_size, size);
+            std::copy(binary, binary + num_copied, carry + carry_size);
+            carry_size += num_copied;
+            binary += num_copied;
+            size -= num_copied;
+            if (carry_size < bbs) {
+                continue;
+            }
+            CodecImpl::encode_continued(encoded_result, state, carry, bbs, num_symbols);
+            carry_size = 0;
+        }
+        size_t num_block_bytes = size - size % bbs;
+        CodecImpl::encode_continued(encoded_result, state, binary, num_block_bytes, num_symbols);
+        std::copy(binary + num_block_bytes, binary + size, carry);
+        carry_size = size - num_block_bytes;
+    }
+    CodecImpl::encode_continued(encoded_result, state, carry, carry_size, num_symbols);
+    data::finish(encoded_result, state);
+    assert(data::size(encoded_result) == encoded_buffer_size);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Checksum>
+inline void codec<CodecImpl>::encode_with_checksum(Result& encoded_result, Checksum& checksum,
+        const uint8_t* binary, size_t binary_size)
+{
+    // Small enough that the checksum leaves each chunk in L1 cache for the encoder to read.
+    constexpr const size_t chunk_size = CodecImpl::binary_block_size() * 1024;
+
+    size_t encoded_buffer_size = encoded_size(binary_size);
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_buffer_size);
+
+    size_t num_symbols = 0;
+    for (; binary_size > chunk_size; binary += chunk_size, binary_size -= chunk_size) {
+        checksum.update(binary, chunk_size);
+        CodecImpl::encode_continued(encoded_result, state, binary, chunk_size, num_symbols);
+    }
+    checksum.update(binary, binary_size);
+    CodecImpl::encode_continued(encoded_result, state, binary, binary_size, num_symbols);
+
+    data::finish(encoded_result, state);
+    assert(data::size(encoded_result) == encoded_buffer_size);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Checksum, typename T>
+inline void codec<CodecImpl>::encode_with_checksum(
+        Result& encoded_result, Checksum& checksum, const T& binary)
+{
+    encode_with_checksum(encoded_result, checksum, data::uchar_data(binary), data::size(binary));
+}
+
 template <typename CodecImpl>
 inline size_t codec<CodecImpl>::encode(
         char* encoded_result, size_t encoded_buffer_size,
@@ -226,12 +666,69 @@ inline size_t codec<CodecImpl>::encode(
     return encode(encoded_result, encoded_buffer_size, data::uchar_data(binary), data::size(binary));
 }
 
+template <typename CodecImpl>
+template <size_t BinarySize>
+inline typename codec<CodecImpl>::template encoded_fixed_string<BinarySize>
+codec<CodecImpl>::encode_fixed(const uint8_t* binary)
+{
+    encoded_fixed_string<BinarySize> encoded_result;
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_size(BinarySize));
+
+    CodecImpl::template encode_unrolled<BinarySize>(encoded_result, state, binary);
+    data::finish(encoded_result, state);
+    return encoded_result;
+}
+
+template <typename CodecImpl>
+template <size_t BinarySize>
+inline typename codec<CodecImpl>::template encoded_fixed_string<BinarySize>
+codec<CodecImpl>::encode_fixed(const uint8_t (&binary)[BinarySize])
+{
+    return encode_fixed<BinarySize>(&binary[0]);
+}
+
+template <typename CodecImpl>
+template <size_t BinarySize>
+inline typename codec<CodecImpl>::template encoded_fixed_string<BinarySize>
+codec<CodecImpl>::encode_fixed(const std::array<uint8_t, BinarySize>& binary)
+{
+    return encode_fixed<BinarySize>(binary.data());
+}
+
+template <typename CodecImpl>
+template <size_t BinarySize>
+inline CPPCODEC_CONSTEXPR_CXX17 std::array<char, CodecImpl::encoded_size(BinarySize)>
+codec<CodecImpl>::encode_array(const std::array<uint8_t, BinarySize>& binary)
+{
+    std::array<char, CodecImpl::encoded_size(BinarySize)> encoded_result{};
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_size(BinarySize));
+
+    // The input size is known at compile time, so every block and the tail are unrolled.
+    CodecImpl::template encode_unrolled<BinarySize>(encoded_result, state, binary.data());
+    data::finish(encoded_result, state);
+    return encoded_result;
+}
+
 template <typename CodecImpl>
 inline constexpr size_t codec<CodecImpl>::encoded_size(size_t binary_size) noexcept
 {
     return CodecImpl::encoded_size(binary_size);
 }
 
+template <typename CodecImpl>
+inline constexpr size_t codec<CodecImpl>::binary_block_size() noexcept
+{
+    return CodecImpl::binary_block_size();
+}
+
+template <typename CodecImpl>
+inline constexpr size_t codec<CodecImpl>::encoded_block_size() noexcept
+{
+    return CodecImpl::encoded_block_size();
+}
+
 
 //
 // Decoding
@@ -260,7 +757,8 @@ inline Result codec<CodecImpl>::decode(const T& encoded)
 
 template <typename CodecImpl>
 template <typename Result>
-inline void codec<CodecImpl>::decode(Result& binary_result, const char* encoded, size_t encoded_size)
+inline CPPCODEC_CONSTEXPR_CXX17 void codec<CodecImpl>::decode(
+        Result& binary_result, const char* encoded, size_t encoded_size)
 {
     // This overload is where we reserve buffer capacity and call into CodecImpl.
     size_t binary_buffer_size = decoded_max_size(encoded_size);
@@ -280,6 +778,208 @@ inline void codec<CodecImpl>::decode(Result& binary_result, const T& encoded)
     decode(binary_result, data::char_data(encoded), data::size(encoded));
 }
 
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decode_append(
+        Result& binary_result, const char* encoded, size_t encoded_size)
+{
+    size_t binary_buffer_size = decoded_max_size(encoded_size);
+    size_t orig_size = data::size(binary_result);
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init_append(binary_result, state, binary_buffer_size);
+
+    try {
+        CodecImpl::decode(binary_result, state, encoded, encoded_size);
+    } catch (const parse_error&) {
+        // Don't leave a partially decoded tail behind the existing contents.
+        data::truncate(binary_result, orig_size);
+        throw;
+    }
+    data::finish(binary_result, state);
+    assert(data::size(binary_result) <= orig_size + binary_buffer_size);
+    (void) orig_size;
+}
+
+template <typename CodecImpl>
+template <typename Result, typename T>
+inline void codec<CodecImpl>::decode_append(Result& binary_result, const T& encoded)
+{
+    decode_append(binary_result, data::char_data(encoded), data::size(encoded));
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Valid>
+inline void codec<CodecImpl>::decode_batch(Result& binary_result, Valid& valid, size_t binary_size,
+        const char* encoded, size_t token_size, size_t num_tokens)
+{
+    constexpr const size_t num_lanes = 8;
+
+    valid.resize(num_tokens);
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init(binary_result, state, num_tokens * binary_size);
+
+    // decode_lanes() needs contiguous memory, so the lanes are decoded into a small buffer
+    // and then put into the result one byte at a time, as with decode().
+    std::vector<uint8_t> lanes(num_lanes * binary_size);
+    auto put_lanes = [&](size_t num_tokens_in_lanes) {
+        for (size_t i = 0; i < num_tokens_in_lanes * binary_size; ++i) {
+            data::put(binary_result, state, lanes[i]);
+        }
+    };
+
+    // Tokens that can't be decoded side by side with the others fall back to regular decoding.
+    std::vector<uint8_t> scratch;
+    auto decode_fallback = [&](size_t token, uint8_t* dst) {
+        try {
+            decode(scratch, encoded + token * token_size, token_size);
+            valid[token] = (scratch.size() == binary_size);
+        } catch (const parse_error&) {
+            valid[token] = false;
+        }
+        if (valid[token]) {
+            std::copy(scratch.begin(), scratch.end(), dst);
+        } else {
+            std::fill(dst, dst + binary_size, static_cast<uint8_t>(0));
+        }
+    };
+
+    size_t token = 0;
+    for (; token + num_lanes <= num_tokens; token += num_lanes) {
+        uint_fast32_t fallback_lanes = CodecImpl::template decode_lanes<num_lanes>(
+                lanes.data(), binary_size, encoded + token * token_size, token_size);
+        for (size_t lane = 0; lane < num_lanes; ++lane) {
+            valid[token + lane] = true;
+        }
+        for (size_t lane = 0; fallback_lanes; ++lane, fallback_lanes >>= 1) {
+            if (fallback_lanes & 1) {
+                decode_fallback(token + lane, lanes.data() + lane * binary_size);
+            }
+        }
+        put_lanes(num_lanes);
+    }
+    for (; token < num_tokens; ++token) {
+        valid[token] = true;
+        if (CodecImpl::template decode_lanes<1>(
+                lanes.data(), binary_size, encoded + token * token_size, token_size)) {
+            decode_fallback(token, lanes.data());
+        }
+        put_lanes(1);
+    }
+    data::finish(binary_result, state);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename Segments>
+inline void codec<CodecImpl>::decode_gather(Result& binary_result, const Segments& segments)
+{
+    size_t encoded_size = 0;
+    for (const auto& segment : segments) {
+        encoded_size += segment_size(segment);
+    }
+    size_t binary_buffer_size = decoded_max_size(encoded_size);
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init(binary_result, state, binary_buffer_size);
+
+    // Symbols of a block that straddles a segment boundary are carried over in the decode state.
+    resumable_decode_state decode_state;
+    for (const auto& segment : segments) {
+        CodecImpl::decode_partial(binary_result, state, decode_state,
+                reinterpret_cast<const char*>(segment_data(segment)), segment_size(segment));
+    }
+    CodecImpl::decode_finish(binary_result, state, decode_state);
+    data::finish(binary_result, state);
+    assert(data::size(binary_result) <= binary_buffer_size);
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decode_range(Result& binary_result, const char* encoded, size_t encoded_size,
+        size_t offset, size_t length)
+{
+    static_assert(decodes_in_pieces<CodecImpl>::value,
+            "decode_range() is not available for codecs with a checksum, such as base64_openpgp "
+            "or base32_crockford_check");
+    static_assert(!CodecImpl::ignores_characters(),
+            "decode_range() can't locate blocks in variants that ignore characters, such as line breaks "
+            "in base64_mime or hyphens in base32_crockford, use the seek_index overload instead");
+    constexpr const size_t bbs = CodecImpl::binary_block_size();
+    constexpr const size_t ebs = CodecImpl::encoded_block_size();
+
+    // Without ignored characters, block i is always at [i * ebs, (i + 1) * ebs) in the encoded string.
+    size_t first_block = offset / bbs;
+    size_t end_block = offset / bbs + (offset % bbs + length + bbs - 1) / bbs;
+    size_t encoded_begin = first_block * ebs;
+    if (encoded_begin > encoded_size) {
+        throw invalid_input_length("byte range starts after the end of the decoded data");
+    }
+    size_t encoded_end = std::min(end_block * ebs, encoded_size);
+    decode_blocks(binary_result, encoded, encoded_begin, encoded_end, offset % bbs, length);
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decode_range(Result& binary_result, const seek_index& index,
+        const char* encoded, size_t encoded_size, size_t offset, size_t length)
+{
+    static_assert(decodes_in_pieces<CodecImpl>::value,
+            "decode_range() is not available for codecs with a checksum, such as base64_openpgp "
+            "or base32_crockford_check");
+    constexpr const size_t bbs = CodecImpl::binary_block_size();
+    constexpr const size_t ebs = CodecImpl::encoded_block_size();
+
+    // Jump to the closest preceding index entry, then count symbols from there.
+    size_t first_block = offset / bbs;
+    size_t end_block = offset / bbs + (offset % bbs + length + bbs - 1) / bbs;
+    const typename seek_index::entry& entry = index.find(first_block * bbs);
+    if (entry.encoded_offset > encoded_size) {
+        throw invalid_input_length("seek index doesn't match the encoded string");
+    }
+    size_t encoded_begin = entry.encoded_offset + CodecImpl::skip_symbols(
+            encoded + entry.encoded_offset, encoded_size - entry.encoded_offset,
+            (first_block - entry.binary_offset / bbs) * ebs);
+    size_t encoded_end = encoded_begin + CodecImpl::skip_symbols(
+            encoded + encoded_begin, encoded_size - encoded_begin, (end_block - first_block) * ebs);
+    decode_blocks(binary_result, encoded, encoded_begin, encoded_end, offset % bbs, length);
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decode_blocks(Result& binary_result, const char* encoded,
+        size_t encoded_begin, size_t encoded_end, size_t skip, size_t length)
+{
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init(binary_result, state, length);
+
+    range_result<Result, decltype(state)> range(binary_result, state, skip, length);
+    data::empty_result_state range_state;
+    try {
+        CodecImpl::decode(range, range_state, encoded + encoded_begin, encoded_end - encoded_begin);
+    } catch (const symbol_error& e) {
+        throw symbol_error(e.symbol(), encoded_begin + e.offset());
+    }
+    if (range.remaining()) {
+        throw invalid_input_length("byte range ends after the end of the decoded data");
+    }
+    data::finish(binary_result, state);
+    assert(data::size(binary_result) == length);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename T>
+inline void codec<CodecImpl>::decode_range(
+        Result& binary_result, const T& encoded, size_t offset, size_t length)
+{
+    decode_range(binary_result, data::char_data(encoded), data::size(encoded), offset, length);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename T>
+inline void codec<CodecImpl>::decode_range(
+        Result& binary_result, const seek_index& index, const T& encoded, size_t offset, size_t length)
+{
+    decode_range(binary_result, index, data::char_data(encoded), data::size(encoded), offset, length);
+}
+
 template <typename CodecImpl>
 inline size_t codec<CodecImpl>::decode(
         uint8_t* binary_result, size_t binary_buffer_size,
@@ -314,12 +1014,210 @@ inline size_t codec<CodecImpl>::decode(char* binary_result, size_t binary_buffer
     return decode(binary_result, binary_buffer_size, data::char_data(encoded), data::size(encoded));
 }
 
+template <typename CodecImpl>
+template <size_t N>
+inline typename codec<CodecImpl>::template decoded_fixed_bytes<N - 1>
+codec<CodecImpl>::decode_fixed(const char (&encoded)[N])
+{
+    assert(encoded[N - 1] == '\0'); // use the std::array overload for unterminated arrays
+    decoded_fixed_bytes<N - 1> binary_result;
+    decode(binary_result, &encoded[0], N - 1);
+    return binary_result;
+}
+
+template <typename CodecImpl>
+template <size_t EncodedSize>
+inline typename codec<CodecImpl>::template decoded_fixed_bytes<EncodedSize>
+codec<CodecImpl>::decode_fixed(const std::array<char, EncodedSize>& encoded)
+{
+    decoded_fixed_bytes<EncodedSize> binary_result;
+    decode(binary_result, encoded.data(), EncodedSize);
+    return binary_result;
+}
+
+template <typename CodecImpl>
+template <size_t BinarySize>
+inline CPPCODEC_CONSTEXPR_CXX17 std::array<uint8_t, BinarySize> codec<CodecImpl>::decode_array(
+        const char* encoded, size_t encoded_size)
+{
+    if (decoded_size(encoded, encoded_size) != BinarySize) {
+        throw invalid_input_length("decoded size does not match the size of the result array");
+    }
+    std::array<uint8_t, BinarySize> binary_result{};
+    decode(binary_result, encoded, encoded_size);
+    return binary_result;
+}
+
 template <typename CodecImpl>
 inline constexpr size_t codec<CodecImpl>::decoded_max_size(size_t encoded_size) noexcept
 {
     return CodecImpl::decoded_max_size(encoded_size);
 }
 
+template <typename CodecImpl>
+inline CPPCODEC_CONSTEXPR_CXX17 size_t codec<CodecImpl>::decoded_size(
+        const char* encoded, size_t encoded_size) noexcept
+{
+    return CodecImpl::decoded_size(encoded, encoded_size);
+}
+
+template <typename CodecImpl>
+template <typename T>
+inline size_t codec<CodecImpl>::decoded_size(const T& encoded) noexcept
+{
+    return decoded_size(data::char_data(encoded), data::size(encoded));
+}
+
+template <typename CodecImpl>
+inline bool codec<CodecImpl>::validate(const char* encoded, size_t encoded_size) noexcept
+{
+    return CodecImpl::validate(encoded, encoded_size);
+}
+
+template <typename CodecImpl>
+template <typename T>
+inline bool codec<CodecImpl>::validate(const T& encoded) noexcept
+{
+    return validate(data::char_data(encoded), data::size(encoded));
+}
+
+template <typename CodecImpl>
+inline bool codec<CodecImpl>::equals(const char* encoded, size_t encoded_size,
+        const uint8_t* binary, size_t binary_size) noexcept
+{
+    // Decode a few blocks at a time, and stop as soon as they don't match.
+    constexpr const size_t chunk_size = CodecImpl::encoded_block_size() * 16;
+
+    compare_result result(binary, binary_size);
+    data::empty_result_state state;
+    resumable_decode_state decode_state;
+    try {
+        for (size_t pos = 0; pos < encoded_size; pos += chunk_size) {
+            CodecImpl::decode_partial(result, state, decode_state,
+                    encoded + pos, std::min(chunk_size, encoded_size - pos));
+            if (result.mismatch()) {
+                return false;
+            }
+        }
+        CodecImpl::decode_finish(result, state, decode_state);
+    } catch (const parse_error&) {
+        return false;
+    }
+    return result.equal();
+}
+
+template <typename CodecImpl>
+template <typename E, typename B>
+inline bool codec<CodecImpl>::equals(const E& encoded, const B& binary) noexcept
+{
+    return equals(data::char_data(encoded), data::size(encoded),
+            data::uchar_data(binary), data::size(binary));
+}
+
+template <typename CodecImpl>
+inline bool codec<CodecImpl>::equals_constant_time(const char* encoded, size_t encoded_size,
+        const uint8_t* binary, size_t binary_size) noexcept
+{
+    compare_result result(binary, binary_size);
+    data::empty_result_state state;
+    try {
+        CodecImpl::decode(result, state, encoded, encoded_size);
+    } catch (const parse_error&) {
+        return false;
+    }
+    return result.equal();
+}
+
+template <typename CodecImpl>
+template <typename E, typename B>
+inline bool codec<CodecImpl>::equals_constant_time(const E& encoded, const B& binary) noexcept
+{
+    return equals_constant_time(data::char_data(encoded), data::size(encoded),
+            data::uchar_data(binary), data::size(binary));
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decoder::decode(
+        Result& binary_result, const char* encoded, size_t encoded_size)
+{
+    size_t binary_buffer_size = decoded_max_size(m_state.num_indexes + encoded_size);
+    size_t orig_size = data::size(binary_result);
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init_append(binary_result, state, binary_buffer_size);
+
+    try {
+        CodecImpl::decode_partial(binary_result, state, m_state, encoded, encoded_size);
+    } catch (const parse_error&) {
+        // Don't leave a partially decoded tail behind the existing contents.
+        data::truncate(binary_result, orig_size);
+        throw;
+    }
+    data::finish(binary_result, state);
+}
+
+template <typename CodecImpl>
+template <typename Result, typename T>
+inline void codec<CodecImpl>::decoder::decode(Result& binary_result, const T& encoded)
+{
+    decode(binary_result, data::char_data(encoded), data::size(encoded));
+}
+
+template <typename CodecImpl>
+template <typename Result>
+inline void codec<CodecImpl>::decoder::finish(Result& binary_result)
+{
+    size_t orig_size = data::size(binary_result);
+    auto state = data::create_state(binary_result, data::specific_t());
+    data::init_append(binary_result, state, CodecImpl::binary_block_size());
+
+    try {
+        CodecImpl::decode_finish(binary_result, state, m_state);
+    } catch (const parse_error&) {
+        data::truncate(binary_result, orig_size);
+        reset();
+        throw;
+    }
+    data::finish(binary_result, state);
+}
+
+template <typename CodecImpl>
+inline codec<CodecImpl>::seek_index::seek_index(const char* encoded, size_t encoded_size, size_t interval)
+{
+    constexpr const size_t bbs = CodecImpl::binary_block_size();
+    constexpr const size_t ebs = CodecImpl::encoded_block_size();
+
+    size_t interval_blocks = std::max(static_cast<size_t>(1), (interval + bbs - 1) / bbs);
+    m_interval = interval_blocks * bbs;
+    m_entries.push_back(entry{0, 0});
+
+    size_t pos = CodecImpl::skip_symbols(encoded, encoded_size, interval_blocks * ebs);
+    while (pos < encoded_size) {
+        m_entries.push_back(entry{pos, m_entries.size() * m_interval});
+        pos += CodecImpl::skip_symbols(encoded + pos, encoded_size - pos, interval_blocks * ebs);
+    }
+}
+
+template <typename CodecImpl>
+template <typename T>
+inline codec<CodecImpl>::seek_index::seek_index(const T& encoded, size_t interval)
+    : seek_index(data::char_data(encoded), data::size(encoded), interval)
+{
+}
+
+template <typename CodecImpl>
+inline const typename codec<CodecImpl>::seek_index::entry& codec<CodecImpl>::seek_index::find(
+        size_t binary_offset) const noexcept
+{
+    // Entries are evenly spaced in the decoded data.
+    return m_entries[std::min(binary_offset / m_interval, m_entries.size() - 1)];
+}
+
+
+// Gives access to the codec implementation behind a public codec type, for extensions such as
+// the multi-threaded functions in parallel.hpp that need its lower-level building blocks.
+template <typename Codec> struct codec_impl_of;
+template <typename CodecImpl> struct codec_impl_of<codec<CodecImpl>> { using type = CodecImpl; };
 
 } // namespace detail
 } // namespace cppcodec
@@ -36,5 +36,13 @@
 #define CPPCODEC_ALWAYS_INLINE inline
 #endif
 
+// Encoding and decoding can be evaluated at compile time starting with C++17,
+// which is the first standard where std::array is mutable in constant expressions.
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define CPPCODEC_CONSTEXPR_CXX17 constexpr
+#else
+#define CPPCODEC_CONSTEXPR_CXX17
+#endif
+
 #endif // CPPCODEC_DETAIL_CONFIG_HPP
 
@@ -81,18 +81,18 @@ public:
     }
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_block(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_block(
             Result& decoded, ResultState&, const alphabet_index_t* idx);
 
     template <typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void decode_tail(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void decode_tail(
             Result& decoded, ResultState&, const alphabet_index_t* idx, size_t idx_len);
 };
 
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void hex<CodecVariant>::decode_block(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void hex<CodecVariant>::decode_block(
         Result& decoded, ResultState& state, const alphabet_index_t* idx)
 {
     data::put(decoded, state, static_cast<uint8_t>((idx[0] << 4) | idx[1]));
@@ -100,7 +100,7 @@ CPPCODEC_ALWAYS_INLINE void hex<CodecVariant>::decode_block(
 
 template <typename CodecVariant>
 template <typename Result, typename ResultState>
-CPPCODEC_ALWAYS_INLINE void hex<CodecVariant>::decode_tail(
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void hex<CodecVariant>::decode_tail(
         Result&, ResultState&, const alphabet_index_t*, size_t)
 {
     throw invalid_input_length(
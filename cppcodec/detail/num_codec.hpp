@@ -0,0 +1,489 @@
+/**
+ *  Copyright (C) 2016 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_DETAIL_NUM_CODEC
+#define CPPCODEC_DETAIL_NUM_CODEC
+
+#include <stdint.h>
+#include <stdlib.h> // for abort()
+#include <string.h> // for memcpy()
+#include <string>
+#include <type_traits>
+
+#include "../data/access.hpp"
+#include "../parse_error.hpp"
+#include "config.hpp"
+#include "stream_codec.hpp" // for alphabet_index_info
+
+namespace cppcodec {
+
+// Order of the bytes of a number in fixed-width hex, most significant first (as numbers are
+// usually written) or least significant first (as they are stored on little-endian CPUs).
+enum class byte_order { big_endian, little_endian };
+
+namespace detail {
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128_num_t;
+#endif
+
+// Unsigned integer types that a place-based number codec can encode and decode.
+// std::is_unsigned<unsigned __int128> is only true with GNU extensions enabled, so list it explicitly.
+template <typename T>
+struct is_num_codec_type : std::integral_constant<bool,
+        std::is_integral<T>::value && std::is_unsigned<T>::value && !std::is_same<T, bool>::value> { };
+#ifdef __SIZEOF_INT128__
+template <> struct is_num_codec_type<uint128_num_t> : std::true_type { };
+#endif
+
+// Number of significant bits, but at least 1 so that zero still gets a symbol.
+template <typename T>
+static CPPCODEC_ALWAYS_INLINE size_t num_significant_bits(T number) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(T) <= sizeof(unsigned int))
+            ? sizeof(unsigned int) * 8 - static_cast<size_t>(
+                    __builtin_clz(static_cast<unsigned int>(number) | 1u))
+            : sizeof(unsigned long long) * 8 - static_cast<size_t>(
+                    __builtin_clzll(static_cast<unsigned long long>(number) | 1u));
+#else
+    size_t num_bits = 1;
+    while (number >>= 1) {
+        ++num_bits;
+    }
+    return num_bits;
+#endif
+}
+
+#ifdef __SIZEOF_INT128__
+template <>
+CPPCODEC_ALWAYS_INLINE size_t num_significant_bits<uint128_num_t>(uint128_num_t number) noexcept
+{
+    uint64_t high = static_cast<uint64_t>(number >> 64);
+    return high ? 64 + num_significant_bits(high)
+            : num_significant_bits(static_cast<uint64_t>(number));
+}
+#endif
+
+template <typename T>
+static CPPCODEC_ALWAYS_INLINE T swap_bytes(T number) noexcept
+{
+    T swapped = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        swapped = static_cast<T>((swapped << 8) | ((number >> (i * 8)) & 0xFF));
+    }
+    return swapped;
+}
+
+// Converts eight hex symbols at a time from and to a 32-bit number, with one symbol
+// per byte of a uint64_t. The first symbol is the most significant byte, so that a plain
+// big-endian store or load puts it first in memory.
+struct swar_hex
+{
+    static constexpr const uint64_t ones = 0x0101010101010101ull;
+    static constexpr const uint64_t high_bits = 0x8080808080808080ull;
+    static constexpr const uint64_t nibbles = 0x0F0F0F0F0F0F0F0Full;
+
+    // letter_offset is the distance from '0' + 10 to the symbol for 10, i.e. 'A' or 'a'.
+    static CPPCODEC_ALWAYS_INLINE uint64_t format(uint32_t number, uint8_t letter_offset) noexcept
+    {
+        // Spread the nibbles out into one byte each: 0x1234ABCD -> 0x010203040A0B0C0D.
+        uint64_t v = number;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & nibbles;
+        // Adding 6 carries into bit 4 for 10 and above, those get the letter offset on top of '0'.
+        uint64_t is_letter = ((v + 6 * ones) >> 4) & ones;
+        return v + '0' * ones + is_letter * letter_offset;
+    }
+
+    // Returns false if any of the symbols isn't 0-9, A-F or a-f.
+    static CPPCODEC_ALWAYS_INLINE bool parse(uint64_t symbols, uint32_t& number) noexcept
+    {
+        // For 7-bit bytes, adding 128 - k sets the high bit exactly for k and above.
+        uint64_t c = symbols & ~high_bits;
+        uint64_t lower = c | (0x20 * ones);
+        uint64_t is_digit = (c + (128 - '0') * ones) & ~(c + (128 - '9' - 1) * ones);
+        uint64_t is_letter = (lower + (128 - 'a') * ones) & ~(lower + (128 - 'f' - 1) * ones);
+        if (((is_digit | is_letter) & ~symbols & high_bits) != high_bits) {
+            return false;
+        }
+        // '0' to '9' and 'a' to 'f' end in 0 to 9 and 1 to 6, letters need 9 more.
+        uint64_t v = (c & nibbles) + ((is_letter & high_bits) >> 7) * 9;
+        v = (v | (v >> 4)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v >> 8)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v >> 16)) & 0x00000000FFFFFFFFull;
+        number = static_cast<uint32_t>(v);
+        return true;
+    }
+
+#if defined(__BYTE_ORDER__) || defined(_MSC_VER)
+    static CPPCODEC_ALWAYS_INLINE uint64_t big_endian(uint64_t symbols) noexcept
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return symbols;
+#elif defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return __builtin_bswap64(symbols);
+#else // MSVC only targets little-endian CPUs
+        return _byteswap_uint64(symbols);
+#endif
+    }
+#endif
+
+    static CPPCODEC_ALWAYS_INLINE void store(char* dest, uint64_t symbols) noexcept
+    {
+#if defined(__BYTE_ORDER__) || defined(_MSC_VER)
+        symbols = big_endian(symbols);
+        memcpy(dest, &symbols, sizeof(symbols));
+#else
+        for (size_t i = 0; i < 8; ++i) {
+            dest[i] = static_cast<char>(symbols >> (56 - i * 8));
+        }
+#endif
+    }
+
+    static CPPCODEC_ALWAYS_INLINE uint64_t load(const char* src) noexcept
+    {
+#if defined(__BYTE_ORDER__) || defined(_MSC_VER)
+        uint64_t symbols;
+        memcpy(&symbols, src, sizeof(symbols));
+        return big_endian(symbols);
+#else
+        uint64_t symbols = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            symbols = (symbols << 8) | static_cast<uint8_t>(src[i]);
+        }
+        return symbols;
+#endif
+    }
+};
+
+/**
+ * Public interface for place-based single number codecs. For API documentation, see README.md.
+ *
+ * The encoded string is a single number in base 2^BitsPerSymbol, most significant symbol first,
+ * so the number is zero-extended to the left (e.g. hex "F" is 15) instead of to the right like
+ * in a stream codec. Symbols are shifted in and out of the number, there's no division.
+ */
+template <typename CodecVariant, size_t BitsPerSymbol>
+class num_codec
+{
+public:
+    //
+    // Encoding, without leading zeros. Zero is encoded as a single '0' symbol.
+
+    // Convenient version with templated result type, std::string by default.
+    template <typename Result = std::string, typename T> static Result encode(T number);
+
+    // Reused result container version. Resizes encoded_result before writing to it.
+    template <typename Result, typename T> static void encode(Result& encoded_result, T number);
+
+    // Raw pointer output, assumes pre-allocated memory with size >= encoded_size(number).
+    // Writes null termination if there is room for it.
+    template <typename T>
+    static size_t encode(char* encoded_result, size_t encoded_buffer_size, T number) noexcept;
+
+    // Fixed-width version with leading zeros, always encoded_max_size<T>() symbols long.
+    template <typename Result = std::string, typename T> static Result encode_fixed_width(T number);
+    template <typename Result, typename T> static void encode_fixed_width(Result& encoded_result, T number);
+
+    // Fixed-width raw pointer version for hex, writes exactly encoded_max_size<T>() symbols
+    // without null termination. With byte_order::little_endian, the symbols are the same as
+    // for the stream codec on the number's in-memory bytes on a little-endian CPU.
+    template <typename T>
+    static void encode_fixed_width(char* encoded_result, T number, byte_order order) noexcept;
+
+    // Number of symbols for encoding the given number, or any number of type T.
+    template <typename T> static size_t encoded_size(T number) noexcept;
+    template <typename T> static constexpr size_t encoded_max_size() noexcept;
+
+    //
+    // Decoding. Leading zeros are allowed, ignored characters (e.g. hyphens in Crockford base32)
+    // are skipped. Hex variants also skip a "0x" or "0X" prefix, which is never generated.
+    // Throws symbol_error for invalid characters and invalid_input_length if there
+    // are no symbols or if the number doesn't fit into T.
+
+    template <typename T> static T decode(const char* encoded, size_t encoded_size);
+    template <typename T, typename E> static T decode(const E& encoded);
+
+    // Fixed-width version for hex, reads exactly encoded_max_size<T>() symbols
+    // and throws invalid_input_length if there are fewer.
+    template <typename T> static T decode_fixed_width(const char* encoded, byte_order order);
+
+private:
+    static constexpr const size_t symbol_mask = (size_t(1) << BitsPerSymbol) - 1;
+
+    template <typename T> static CPPCODEC_ALWAYS_INLINE void check_type()
+    {
+        static_assert(is_num_codec_type<T>::value, "number must be of an unsigned integer type");
+    }
+
+    // Writes all encoded_max_size<T>() symbols including leading zeros. The shifts are constant
+    // once the loop is unrolled, and there's no dependency between symbols.
+    template <typename T>
+    static CPPCODEC_ALWAYS_INLINE void fixed_width_symbols(char* symbols, T number) noexcept;
+
+    template <typename Result, typename ResultState, typename T>
+    static CPPCODEC_ALWAYS_INLINE void put_symbols(
+            Result& encoded_result, ResultState& state, T number, size_t num_symbols);
+
+    // Decodes the symbols one at a time and counts them, for any input that swar_hex can't take.
+    template <typename T>
+    static T decode_symbols(const char* encoded, size_t encoded_size, size_t& num_symbols);
+
+    // Numbers of at least 32 bits in a hex variant whose alphabet is 0-9 followed by
+    // A-F or a-f, decoding either case, are converted eight symbols at a time by swar_hex.
+    template <typename T> static constexpr bool uses_swar_hex() noexcept
+    {
+        return BitsPerSymbol == 4 && sizeof(T) % 4 == 0
+                && CodecVariant::symbol(0) == '0' && CodecVariant::symbol(9) == '9'
+                && (CodecVariant::symbol(10) == 'A' || CodecVariant::symbol(10) == 'a')
+                && CodecVariant::symbol(15) == CodecVariant::symbol(10) + 5
+                && CodecVariant::normalized_symbol('a') == CodecVariant::normalized_symbol('A')
+                && CodecVariant::normalized_symbol('f') == CodecVariant::normalized_symbol('F');
+    }
+    static constexpr uint8_t letter_offset() noexcept
+    {
+        return static_cast<uint8_t>(CodecVariant::symbol(10) - '0' - 10);
+    }
+};
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename Result, typename T>
+inline Result num_codec<CodecVariant, BitsPerSymbol>::encode(T number)
+{
+    Result encoded_result;
+    encode(encoded_result, number);
+    return encoded_result;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename Result, typename T>
+inline void num_codec<CodecVariant, BitsPerSymbol>::encode(Result& encoded_result, T number)
+{
+    check_type<T>();
+    size_t num_symbols = encoded_size(number);
+
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, num_symbols);
+    put_symbols(encoded_result, state, number, num_symbols);
+    data::finish(encoded_result, state);
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline size_t num_codec<CodecVariant, BitsPerSymbol>::encode(
+        char* encoded_result, size_t encoded_buffer_size, T number) noexcept
+{
+    check_type<T>();
+    size_t num_symbols = encoded_size(number);
+    if (encoded_buffer_size < num_symbols) {
+        abort();
+    }
+    char symbols[encoded_max_size<T>()];
+    fixed_width_symbols(symbols, number);
+    memcpy(encoded_result, symbols + sizeof(symbols) - num_symbols, num_symbols);
+    if (encoded_buffer_size > num_symbols) {
+        encoded_result[num_symbols] = '\0';
+    }
+    return num_symbols;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename Result, typename T>
+inline Result num_codec<CodecVariant, BitsPerSymbol>::encode_fixed_width(T number)
+{
+    Result encoded_result;
+    encode_fixed_width(encoded_result, number);
+    return encoded_result;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename Result, typename T>
+inline void num_codec<CodecVariant, BitsPerSymbol>::encode_fixed_width(Result& encoded_result, T number)
+{
+    check_type<T>();
+
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_max_size<T>());
+    put_symbols(encoded_result, state, number, encoded_max_size<T>());
+    data::finish(encoded_result, state);
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline void num_codec<CodecVariant, BitsPerSymbol>::encode_fixed_width(
+        char* encoded_result, T number, byte_order order) noexcept
+{
+    static_assert(BitsPerSymbol == 4, "byte order only applies to hex symbols");
+    check_type<T>();
+    fixed_width_symbols(encoded_result,
+            order == byte_order::little_endian ? swap_bytes(number) : number);
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline size_t num_codec<CodecVariant, BitsPerSymbol>::encoded_size(T number) noexcept
+{
+    check_type<T>();
+    return (num_significant_bits(number) + BitsPerSymbol - 1) / BitsPerSymbol;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline constexpr size_t num_codec<CodecVariant, BitsPerSymbol>::encoded_max_size() noexcept
+{
+    return (sizeof(T) * 8 + BitsPerSymbol - 1) / BitsPerSymbol;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline T num_codec<CodecVariant, BitsPerSymbol>::decode(const char* encoded, size_t encoded_size)
+{
+    check_type<T>();
+    // 'x' is never a hex symbol, so a prefix can't be confused with a number.
+    const size_t prefix_size = (BitsPerSymbol == 4 && encoded_size >= 2
+            && encoded[0] == '0' && (encoded[1] == 'x' || encoded[1] == 'X')) ? 2 : 0;
+    size_t num_symbols = 0;
+    T number = 0;
+    try {
+        number = decode_symbols<T>(encoded + prefix_size, encoded_size - prefix_size, num_symbols);
+    } catch (const symbol_error& e) {
+        throw symbol_error(e.symbol(), prefix_size + e.offset());
+    }
+    if (!num_symbols) {
+        throw invalid_input_length("parse error: no symbols in the encoded number");
+    }
+    return number;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T, typename E>
+inline T num_codec<CodecVariant, BitsPerSymbol>::decode(const E& encoded)
+{
+    return decode<T>(data::char_data(encoded), data::size(encoded));
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline T num_codec<CodecVariant, BitsPerSymbol>::decode_fixed_width(
+        const char* encoded, byte_order order)
+{
+    static_assert(BitsPerSymbol == 4, "byte order only applies to hex symbols");
+    check_type<T>();
+    // Don't read past the null termination of a shorter string, decode_symbols() would load
+    // eight characters at a time if it got encoded_max_size<T>() as the size.
+    size_t encoded_size = 0;
+    while (encoded_size < encoded_max_size<T>() && encoded[encoded_size] != '\0') {
+        ++encoded_size;
+    }
+    size_t num_symbols = 0;
+    T number = decode_symbols<T>(encoded, encoded_size, num_symbols);
+    if (num_symbols != encoded_max_size<T>()) {
+        throw invalid_input_length("parse error: too few symbols for a fixed-width number");
+    }
+    return order == byte_order::little_endian ? swap_bytes(number) : number;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+inline T num_codec<CodecVariant, BitsPerSymbol>::decode_symbols(
+        const char* encoded, size_t encoded_size, size_t& num_symbols)
+{
+    using info = alphabet_index_info<CodecVariant>;
+
+    if (uses_swar_hex<T>() && encoded_size == encoded_max_size<T>()) {
+        // Fixed width, the number can't overflow. Shifting by 32 is split up for uint32_t.
+        T number = 0;
+        uint32_t part = 0;
+        size_t pos = 0;
+        for (; pos < encoded_size && swar_hex::parse(swar_hex::load(encoded + pos), part); pos += 8) {
+            number = static_cast<T>(((number << 16) << 16) | part);
+        }
+        if (pos == encoded_size) {
+            num_symbols = encoded_size;
+            return number;
+        }
+    }
+
+    // The top symbol bits must be zero before each shift, otherwise the number doesn't fit.
+    constexpr const size_t overflow_shift = sizeof(T) * 8 - BitsPerSymbol;
+
+    T number = 0;
+    T overflow = 0;
+    for (size_t i = 0; i < encoded_size; ++i) {
+        alphabet_index_t idx = info::lookup::for_symbol(encoded[i]);
+        if (info::is_stop_character(idx)) {
+            if (info::is_eof(idx)) {
+                break;
+            }
+            if (info::is_ignored(idx)) {
+                continue;
+            }
+            throw symbol_error(encoded[i], i);
+        }
+        overflow |= number >> overflow_shift;
+        number = static_cast<T>((number << BitsPerSymbol) | static_cast<T>(idx));
+        ++num_symbols;
+    }
+    if (overflow) {
+        throw invalid_input_length("parse error: encoded number is too large for the result type");
+    }
+    return number;
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename Result, typename ResultState, typename T>
+CPPCODEC_ALWAYS_INLINE void num_codec<CodecVariant, BitsPerSymbol>::put_symbols(
+        Result& encoded_result, ResultState& state, T number, size_t num_symbols)
+{
+    char symbols[encoded_max_size<T>()];
+    fixed_width_symbols(symbols, number);
+    for (size_t i = sizeof(symbols) - num_symbols; i < sizeof(symbols); ++i) {
+        data::put(encoded_result, state, symbols[i]);
+    }
+}
+
+template <typename CodecVariant, size_t BitsPerSymbol>
+template <typename T>
+CPPCODEC_ALWAYS_INLINE void num_codec<CodecVariant, BitsPerSymbol>::fixed_width_symbols(
+        char* symbols, T number) noexcept
+{
+    constexpr const size_t num_symbols = encoded_max_size<T>();
+    if (uses_swar_hex<T>()) {
+        for (size_t i = 0; i < num_symbols; i += 8) {
+            uint32_t part = static_cast<uint32_t>(number >> ((num_symbols - 8 - i) * 4));
+            swar_hex::store(symbols + i, swar_hex::format(part, letter_offset()));
+        }
+        return;
+    }
+    for (size_t i = 0; i < num_symbols; ++i) {
+        symbols[num_symbols - 1 - i] = CodecVariant::symbol(static_cast<alphabet_index_t>(
+                (number >> (i * BitsPerSymbol)) & symbol_mask));
+    }
+}
+
+} // namespace detail
+} // namespace cppcodec
+
+#endif // CPPCODEC_DETAIL_NUM_CODEC
@@ -29,6 +29,7 @@
 #include <stdlib.h> // for abort()
 #include <stdint.h>
 
+#include "../data/access.hpp"
 #include "../parse_error.hpp"
 #include "config.hpp"
 
@@ -37,30 +38,134 @@ namespace detail {
 
 using alphabet_index_t = uint_fast16_t;
 
+// Carries an incomplete block from one stream_codec::decode_partial() call to the next.
+struct resumable_decode_state
+{
+    alphabet_index_t indexes[8]; // large enough for any encoded block size
+    uint8_t num_indexes = 0;
+    uint8_t num_padding = 0;
+    bool at_end = false; // an end-of-input symbol was found, ignore anything after it
+    size_t offset = 0; // number of characters consumed so far, for error reporting
+};
+
 template <typename Codec, typename CodecVariant>
 class stream_codec
 {
 public:
-    template <typename Result, typename ResultState> static void encode(
+    template <typename Result, typename ResultState> static CPPCODEC_CONSTEXPR_CXX17 void encode(
             Result& encoded_result, ResultState&, const uint8_t* binary, size_t binary_size);
 
-    template <typename Result, typename ResultState> static void decode(
+    // Same as encode(), for binary data that gets encoded piece by piece into the same result.
+    // All pieces except for the last one must be a multiple of the binary block size.
+    // num_symbols is the number of symbols encoded so far, starting at 0, for line wrapping.
+    template <typename Result, typename ResultState>
+    static CPPCODEC_CONSTEXPR_CXX17 void encode_continued(
+            Result& encoded_result, ResultState&, const uint8_t* binary, size_t binary_size,
+            size_t& num_symbols);
+
+    // Same as encode(), but for a binary size known at compile time: no loop, no tail dispatch.
+    template <size_t BinarySize, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void encode_unrolled(
+            Result& encoded_result, ResultState&, const uint8_t* binary);
+
+    template <typename Result, typename ResultState> static CPPCODEC_CONSTEXPR_CXX17 void decode(
             Result& binary_result, ResultState&, const char* encoded, size_t encoded_size);
 
+    // Resumable version of decode() for input that arrives in pieces. decode_partial() decodes all
+    // complete blocks and keeps the rest in the decode state, decode_finish() decodes the last block.
+    // Together, they accept and reject exactly the same input as a single decode() call.
+    template <typename Result, typename ResultState> static void decode_partial(
+            Result& binary_result, ResultState&, resumable_decode_state& decode_state,
+            const char* encoded, size_t encoded_size);
+    template <typename Result, typename ResultState> static void decode_finish(
+            Result& binary_result, ResultState&, resumable_decode_state& decode_state);
+
     static constexpr size_t encoded_size(size_t binary_size) noexcept;
     static constexpr size_t decoded_max_size(size_t encoded_size) noexcept;
+    static CPPCODEC_CONSTEXPR_CXX17 size_t decoded_size(const char* encoded, size_t encoded_size) noexcept;
+
+    // Returns true if decode() accepts the encoded string, by checking the symbol classes,
+    // padding and the length of the last block with the lookup table, without decoding it.
+    static bool validate(const char* encoded, size_t encoded_size) noexcept;
+
+    // For splitting encoded input into chunks that can be decoded independently:
+    // Counts the symbols (i.e. characters that aren't ignored) before the first end-of-input symbol,
+    // and returns the position of the latter (or encoded_size if there is none).
+    static size_t count_symbols(const char* encoded, size_t encoded_size, size_t& num_symbols) noexcept;
+    // Returns the position right after the num_symbols-th symbol, or encoded_size if there are fewer.
+    static size_t skip_symbols(const char* encoded, size_t encoded_size, size_t num_symbols) noexcept;
+    // True if the variant ignores characters such as line breaks or hyphens, so that the position
+    // of a block in the encoded string can't be calculated from its index alone.
+    static constexpr bool ignores_characters() noexcept;
+
+    // Decodes NumLanes back-to-back tokens of encoded_size characters each side by side,
+    // into binary_size bytes per token. Returns a bit mask of lanes that need to be decoded
+    // with decode() instead: those with padding, ignored or invalid characters, or all of them
+    // if encoded_size doesn't decode to binary_size bytes without padding.
+    template <size_t NumLanes> static uint_fast32_t decode_lanes(
+            uint8_t* binary, size_t binary_size, const char* encoded, size_t encoded_size) noexcept;
+
+private:
+    static constexpr size_t encoded_size_unwrapped(size_t binary_size) noexcept;
+    static constexpr bool is_valid_tail(size_t num_symbols) noexcept;
+
+    template <typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t encode_tail(
+            Result& encoded_result, ResultState&, const uint8_t* binary, size_t binary_size);
+};
+
+static constexpr size_t string_length(const char* str)
+{
+    return *str ? 1 + string_length(str + 1) : 0;
+}
+
+// Line wrapping for codec variants that define line_length() and line_break(), such as MIME.
+// A line break goes between two lines of line_length() symbols each, not after the last line.
+template <typename CodecVariant, typename = void>
+struct line_wrapping { // default for variants without line_length(): no line breaks
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_length() { return 0; }
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_breaks_size(size_t) { return 0; }
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_position(size_t) { return 0; }
+
+    template <typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put_line_break(Result&, ResultState&) { }
+};
+
+template <typename CodecVariant>
+struct line_wrapping<CodecVariant, decltype(void(CodecVariant::line_length()))> {
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_length() { return CodecVariant::line_length(); }
+    // Number of line break characters between num_symbols symbols.
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_breaks_size(size_t num_symbols)
+    {
+        return num_symbols ? (num_symbols - 1) / line_length() * string_length(CodecVariant::line_break()) : 0;
+    }
+    // Number of symbols on the current line after num_symbols symbols, from 1 to line_length().
+    // A full line is only broken once more symbols follow, so that there is no trailing line break.
+    static CPPCODEC_ALWAYS_INLINE constexpr size_t line_position(size_t num_symbols)
+    {
+        return num_symbols ? (num_symbols - 1) % line_length() + 1 : 0;
+    }
+
+    template <typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void put_line_break(
+            Result& encoded, ResultState& state)
+    {
+        for (const char* c = CodecVariant::line_break(); *c; ++c) {
+            data::put(encoded, state, *c);
+        }
+    }
 };
 
 template <bool GeneratesPadding> // default for CodecVariant::generates_padding() == false
 struct padder {
     template <typename CodecVariant, typename Result, typename ResultState, typename SizeT>
-    static CPPCODEC_ALWAYS_INLINE void pad(Result&, ResultState&, SizeT) { }
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void pad(Result&, ResultState&, SizeT) { }
 };
 
 template<> // specialization for CodecVariant::generates_padding() == true
 struct padder<true> {
     template <typename CodecVariant, typename Result, typename ResultState, typename SizeT>
-    static CPPCODEC_ALWAYS_INLINE void pad(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void pad(
             Result& encoded, ResultState& state, SizeT num_padding_characters)
     {
         for (SizeT i = 0; i < num_padding_characters; ++i) {
@@ -73,10 +178,11 @@ template <size_t I>
 struct enc {
     // Block encoding: Go from 0 to (block size - 1), append a symbol for each iteration unconditionally.
     template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void block(Result& encoded, ResultState& state, const uint8_t* src)
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void block(
+            Result& encoded, ResultState& state, const uint8_t* src)
     {
         using EncodedBlockSizeT = decltype(Codec::encoded_block_size());
-        constexpr static const EncodedBlockSizeT SymbolIndex = static_cast<EncodedBlockSizeT>(I - 1);
+        constexpr const EncodedBlockSizeT SymbolIndex = static_cast<EncodedBlockSizeT>(I - 1);
 
         enc<I - 1>().template block<Codec, CodecVariant>(encoded, state, src);
         data::put(encoded, state, CodecVariant::symbol(Codec::template index<SymbolIndex>(src)));
@@ -85,11 +191,11 @@ struct enc {
     // Tail encoding: Go from 0 until (runtime) num_symbols, append a symbol for each iteration.
     template <typename Codec, typename CodecVariant, typename Result, typename ResultState,
             typename EncodedBlockSizeT = decltype(Codec::encoded_block_size())>
-    static CPPCODEC_ALWAYS_INLINE void tail(
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void tail(
             Result& encoded, ResultState& state, const uint8_t* src, EncodedBlockSizeT num_symbols)
     {
-        constexpr static const EncodedBlockSizeT SymbolIndex = Codec::encoded_block_size() - I;
-        constexpr static const EncodedBlockSizeT NumSymbols = SymbolIndex + static_cast<EncodedBlockSizeT>(1);
+        constexpr const EncodedBlockSizeT SymbolIndex = Codec::encoded_block_size() - I;
+        constexpr const EncodedBlockSizeT NumSymbols = SymbolIndex + static_cast<EncodedBlockSizeT>(1);
 
         if (num_symbols == NumSymbols) {
             data::put(encoded, state, CodecVariant::symbol(Codec::template index_last<SymbolIndex>(src)));
@@ -103,11 +209,13 @@ struct enc {
 template<> // terminating specialization
 struct enc<0> {
     template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
-    static CPPCODEC_ALWAYS_INLINE void block(Result&, ResultState&, const uint8_t*) { }
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void block(
+            Result&, ResultState&, const uint8_t*) { }
 
     template <typename Codec, typename CodecVariant, typename Result, typename ResultState,
             typename EncodedBlockSizeT = decltype(Codec::encoded_block_size())>
-    static CPPCODEC_ALWAYS_INLINE void tail(Result&, ResultState&, const uint8_t*, EncodedBlockSizeT)
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void tail(
+            Result&, ResultState&, const uint8_t*, EncodedBlockSizeT)
     {
         abort(); // Not reached: block() should be called if num_symbols == block size, not tail().
     }
@@ -115,12 +223,18 @@ struct enc<0> {
 
 template <typename Codec, typename CodecVariant>
 template <typename Result, typename ResultState>
-inline void stream_codec<Codec, CodecVariant>::encode(
+inline CPPCODEC_CONSTEXPR_CXX17 void stream_codec<Codec, CodecVariant>::encode(
         Result& encoded_result, ResultState& state,
         const uint8_t* src, size_t src_size)
 {
     using encoder = enc<Codec::encoded_block_size()>;
 
+    if (line_wrapping<CodecVariant>::line_length()) {
+        size_t num_symbols = 0;
+        encode_continued(encoded_result, state, src, src_size, num_symbols);
+        return;
+    }
+
     const uint8_t* src_end = src + src_size;
 
     if (src_size >= Codec::binary_block_size()) {
@@ -133,20 +247,162 @@ inline void stream_codec<Codec, CodecVariant>::encode(
     }
 
     if (src_end > src) {
-        auto remaining_src_len = src_end - src;
-        if (!remaining_src_len || remaining_src_len >= Codec::binary_block_size()) {
-            abort();
-            return;
+        encode_tail(encoded_result, state, src, static_cast<size_t>(src_end - src));
+    }
+}
+
+template <typename Codec, typename CodecVariant>
+template <typename Result, typename ResultState>
+inline CPPCODEC_CONSTEXPR_CXX17 void stream_codec<Codec, CodecVariant>::encode_continued(
+        Result& encoded_result, ResultState& state,
+        const uint8_t* src, size_t src_size, size_t& num_symbols)
+{
+    using encoder = enc<Codec::encoded_block_size()>;
+    using wrapping = line_wrapping<CodecVariant>;
+    constexpr const size_t line_length = wrapping::line_length();
+    static_assert(line_length % Codec::encoded_block_size() == 0,
+            "line breaks must fall between two encoded blocks");
+
+    if (!line_length) {
+        encode(encoded_result, state, src, src_size);
+        num_symbols += encoded_size(src_size);
+        return;
+    }
+
+    size_t line_position = wrapping::line_position(num_symbols);
+    size_t num_blocks = src_size / Codec::binary_block_size();
+    num_symbols += num_blocks * Codec::encoded_block_size();
+
+    while (num_blocks) {
+        if (line_position == line_length) {
+            wrapping::put_line_break(encoded_result, state);
+            line_position = 0;
+        }
+        size_t num_line_blocks = (line_length - line_position) / Codec::encoded_block_size();
+        if (num_line_blocks > num_blocks) {
+            num_line_blocks = num_blocks;
+        }
+        for (size_t i = 0; i < num_line_blocks; ++i, src += Codec::binary_block_size()) {
+            encoder::template block<Codec, CodecVariant>(encoded_result, state, src);
         }
+        line_position += num_line_blocks * Codec::encoded_block_size();
+        num_blocks -= num_line_blocks;
+    }
+
+    size_t remaining_src_len = src_size % Codec::binary_block_size();
+    if (remaining_src_len) {
+        if (line_position == line_length) {
+            wrapping::put_line_break(encoded_result, state);
+        }
+        num_symbols += encode_tail(encoded_result, state, src, remaining_src_len);
+    }
+}
+
+template <typename Codec, typename CodecVariant>
+template <typename Result, typename ResultState>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 size_t stream_codec<Codec, CodecVariant>::encode_tail(
+        Result& encoded_result, ResultState& state, const uint8_t* src, size_t src_size)
+{
+    using encoder = enc<Codec::encoded_block_size()>;
+
+    if (!src_size || src_size >= Codec::binary_block_size()) {
+        abort();
+        return 0;
+    }
 
-        auto num_symbols = Codec::num_encoded_tail_symbols(
-                static_cast<uint8_t>(remaining_src_len));
+    auto num_symbols = Codec::num_encoded_tail_symbols(static_cast<uint8_t>(src_size));
 
-        encoder::template tail<Codec, CodecVariant>(encoded_result, state, src, num_symbols);
+    encoder::template tail<Codec, CodecVariant>(encoded_result, state, src, num_symbols);
 
+    padder<CodecVariant::generates_padding()>::template pad<CodecVariant>(
+            encoded_result, state, Codec::encoded_block_size() - num_symbols);
+
+    return CodecVariant::generates_padding() ? Codec::encoded_block_size() : num_symbols;
+}
+
+// Writes the decoded bytes of a single block lane, see stream_codec::decode_lanes().
+class lane_result
+{
+public:
+    explicit lane_result(uint8_t* data) : m_ptr(data) { }
+    CPPCODEC_ALWAYS_INLINE void push_back(uint8_t c) { *m_ptr = c; ++m_ptr; }
+
+private:
+    uint8_t* m_ptr;
+};
+
+// Unrolled block encoding for a compile-time number of blocks. Splits the range in halves
+// rather than recursing once per block, to keep the template recursion depth logarithmic.
+template <size_t NumBlocks>
+struct enc_blocks {
+    template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void block(
+            Result& encoded, ResultState& state, const uint8_t* src)
+    {
+        constexpr const size_t NumFirstBlocks = NumBlocks / 2;
+
+        enc_blocks<NumFirstBlocks>::template block<Codec, CodecVariant>(encoded, state, src);
+        enc_blocks<NumBlocks - NumFirstBlocks>::template block<Codec, CodecVariant>(
+                encoded, state, src + NumFirstBlocks * Codec::binary_block_size());
+    }
+};
+
+template<>
+struct enc_blocks<1> {
+    template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void block(
+            Result& encoded, ResultState& state, const uint8_t* src)
+    {
+        enc<Codec::encoded_block_size()>::template block<Codec, CodecVariant>(encoded, state, src);
+    }
+};
+
+template<>
+struct enc_blocks<0> {
+    template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void block(
+            Result&, ResultState&, const uint8_t*) { }
+};
+
+template <size_t NumTailBytes> // tail encoding with a compile-time number of symbols and padding
+struct enc_fixed_tail {
+    template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void tail(
+            Result& encoded, ResultState& state, const uint8_t* src)
+    {
+        using EncodedBlockSizeT = decltype(Codec::encoded_block_size());
+        constexpr const EncodedBlockSizeT NumSymbols = Codec::num_encoded_tail_symbols(NumTailBytes);
+
+        enc<Codec::encoded_block_size()>::template tail<Codec, CodecVariant>(
+                encoded, state, src, NumSymbols);
         padder<CodecVariant::generates_padding()>::template pad<CodecVariant>(
-                encoded_result, state, Codec::encoded_block_size() - num_symbols);
+                encoded, state, static_cast<EncodedBlockSizeT>(Codec::encoded_block_size() - NumSymbols));
+    }
+};
+
+template<>
+struct enc_fixed_tail<0> {
+    template <typename Codec, typename CodecVariant, typename Result, typename ResultState>
+    static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void tail(
+            Result&, ResultState&, const uint8_t*) { }
+};
+
+template <typename Codec, typename CodecVariant>
+template <size_t BinarySize, typename Result, typename ResultState>
+CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 void stream_codec<Codec, CodecVariant>::encode_unrolled(
+        Result& encoded_result, ResultState& state, const uint8_t* src)
+{
+    constexpr const size_t NumBlocks = BinarySize / Codec::binary_block_size();
+    constexpr const size_t NumTailBytes = BinarySize % Codec::binary_block_size();
+
+    if (line_wrapping<CodecVariant>::line_length()) {
+        encode(encoded_result, state, src, BinarySize);
+        return;
     }
+
+    enc_blocks<NumBlocks>::template block<Codec, CodecVariant>(encoded_result, state, src);
+    enc_fixed_tail<NumTailBytes>::template tail<Codec, CodecVariant>(
+            encoded_result, state, src + NumBlocks * Codec::binary_block_size());
 }
 
 // Range & lookup table generation, see
@@ -233,6 +489,32 @@ struct padding_searcher<CodecVariant, 0> { // terminating specialization
     static CPPCODEC_ALWAYS_INLINE constexpr bool exists_padding_symbol() { return false; }
 };
 
+template <typename CodecVariant, size_t I>
+struct ignored_searcher {
+    static CPPCODEC_ALWAYS_INLINE constexpr bool exists_ignored_symbol()
+    {
+        // Same as padding_searcher, four symbols at a time.
+        static_assert(I % 4 == 0, "I must be divisible by 4 to eventually end at 0");
+
+        return CodecVariant::should_ignore(
+                        static_cast<char>(num_possible_values<char>() - I - 4))
+                || CodecVariant::should_ignore(
+                        static_cast<char>(num_possible_values<char>() - I - 3))
+                || CodecVariant::should_ignore(
+                        static_cast<char>(num_possible_values<char>() - I - 2))
+                || CodecVariant::should_ignore(
+                        static_cast<char>(num_possible_values<char>() - I - 1))
+                || ignored_searcher<CodecVariant, I - 4>::exists_ignored_symbol();
+    }
+};
+template <typename CodecVariant>
+struct ignored_searcher<CodecVariant, 0> { // terminating specialization
+    static CPPCODEC_ALWAYS_INLINE constexpr bool exists_ignored_symbol() { return false; }
+};
+
+template <typename CodecVariant>
+struct alphabet_index_table;
+
 template <typename CodecVariant>
 struct alphabet_index_info
 {
@@ -241,21 +523,30 @@ struct alphabet_index_info
     static constexpr const alphabet_index_t padding_idx = 1 << 8;
     static constexpr const alphabet_index_t invalid_idx = 1 << 9;
     static constexpr const alphabet_index_t eof_idx = 1 << 10;
+    static constexpr const alphabet_index_t ignored_idx = 1 << 11;
     static constexpr const alphabet_index_t stop_character_mask = static_cast<alphabet_index_t>(~0xFFu);
 
     static constexpr const bool padding_allowed = padding_searcher<
             CodecVariant, num_possible_symbols>::exists_padding_symbol();
 
+    static constexpr const bool ignoring_allowed = ignored_searcher<
+            CodecVariant, num_possible_symbols>::exists_ignored_symbol();
+
     static CPPCODEC_ALWAYS_INLINE constexpr bool allows_padding()
     {
         return padding_allowed;
     }
+    static CPPCODEC_ALWAYS_INLINE constexpr bool allows_ignored()
+    {
+        return ignoring_allowed;
+    }
     static CPPCODEC_ALWAYS_INLINE constexpr bool is_padding(alphabet_index_t idx)
     {
         return allows_padding() ? (idx == padding_idx) : false;
     }
     static CPPCODEC_ALWAYS_INLINE constexpr bool is_invalid(alphabet_index_t idx) { return idx == invalid_idx; }
     static CPPCODEC_ALWAYS_INLINE constexpr bool is_eof(alphabet_index_t idx) { return idx == eof_idx; }
+    static CPPCODEC_ALWAYS_INLINE constexpr bool is_ignored(alphabet_index_t idx) { return idx == ignored_idx; }
     static CPPCODEC_ALWAYS_INLINE constexpr bool is_stop_character(alphabet_index_t idx)
     {
         return (idx & stop_character_mask) != 0;
@@ -288,38 +579,57 @@ private:
 #if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
     struct index_at {
         CPPCODEC_ALWAYS_INLINE constexpr alphabet_index_t operator()(size_t symbol) const {
-            return index_of(CodecVariant::normalized_symbol(static_cast<char>(symbol)));
+            return CodecVariant::should_ignore(static_cast<char>(symbol)) ? ignored_idx
+                    : index_of(CodecVariant::normalized_symbol(static_cast<char>(symbol)));
         }
     };
 #else
     static CPPCODEC_ALWAYS_INLINE constexpr alphabet_index_t index_at(size_t symbol)
     {
-        return index_of(CodecVariant::normalized_symbol(static_cast<char>(symbol)));
+        return CodecVariant::should_ignore(static_cast<char>(symbol)) ? ignored_idx
+                : index_of(CodecVariant::normalized_symbol(static_cast<char>(symbol)));
     }
 #endif
 
+    friend struct alphabet_index_table<CodecVariant>;
+
 public:
     struct lookup {
-        static CPPCODEC_ALWAYS_INLINE alphabet_index_t for_symbol(char symbol)
+        static CPPCODEC_ALWAYS_INLINE CPPCODEC_CONSTEXPR_CXX17 alphabet_index_t for_symbol(char symbol)
         {
+            return alphabet_index_table<CodecVariant>::table.lookup[static_cast<uint8_t>(symbol)];
+        }
+    };
+};
+
+// The lookup table is a static data member rather than a function-local static variable,
+// so that lookups can also be evaluated in constant expressions.
+template <typename CodecVariant>
+struct alphabet_index_table
+{
+    using info = alphabet_index_info<CodecVariant>;
+
 #if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
-            static constexpr const auto t = make_lookup_table<num_possible_symbols>(index_at());
+    static constexpr const lookup_table_t<info::num_possible_symbols> table =
+            make_lookup_table<info::num_possible_symbols>(typename info::index_at());
 #else
-            static constexpr const auto t = make_lookup_table<num_possible_symbols>(&index_at);
+    static constexpr const lookup_table_t<info::num_possible_symbols> table =
+            make_lookup_table<info::num_possible_symbols>(&info::index_at);
 #endif
-            static_assert(t.size == num_possible_symbols,
-                    "lookup table must cover each possible (character) symbol");
-            return t.lookup[static_cast<uint8_t>(symbol)];
-        }
-    };
+    static_assert(table.size == info::num_possible_symbols,
+            "lookup table must cover each possible (character) symbol");
 };
 
+template <typename CodecVariant>
+constexpr const lookup_table_t<alphabet_index_info<CodecVariant>::num_possible_symbols>
+        alphabet_index_table<CodecVariant>::table;
+
 //
 // At long last! The actual decode/encode functions.
 
 template <typename Codec, typename CodecVariant>
 template <typename Result, typename ResultState>
-inline void stream_codec<Codec, CodecVariant>::decode(
+inline CPPCODEC_CONSTEXPR_CXX17 void stream_codec<Codec, CodecVariant>::decode(
         Result& binary_result, ResultState& state,
         const char* src_encoded, size_t src_size)
 {
@@ -335,25 +645,21 @@ inline void stream_codec<Codec, CodecVariant>::decode(
     alphabet_index_t* alphabet_index_ptr = &alphabet_indexes[0];
 
     while (src < src_end) {
-        if (CodecVariant::should_ignore(*src)) {
-            ++src;
-            continue;
-        }
+        // Ignored characters are stop characters too, so that valid symbols take a single branch.
         *alphabet_index_ptr = alphabet_index_lookup::for_symbol(*src);
         if (alphabet_index_info<CodecVariant>::is_stop_character(*alphabet_index_ptr)) {
-            break;
-        }
-        ++src;
-        ++alphabet_index_ptr;
-
-        if (alphabet_index_ptr == alphabet_index_end) {
+            if (!alphabet_index_info<CodecVariant>::is_ignored(*alphabet_index_ptr)) {
+                break;
+            }
+        } else if (++alphabet_index_ptr == alphabet_index_end) {
             Codec::decode_block(binary_result, state, alphabet_indexes);
             alphabet_index_ptr = alphabet_index_start;
         }
+        ++src;
     }
 
     if (alphabet_index_info<CodecVariant>::is_invalid(*alphabet_index_ptr)) {
-        throw symbol_error(*src);
+        throw symbol_error(*src, static_cast<size_t>(src - src_encoded));
     }
     ++src;
 
@@ -369,13 +675,15 @@ inline void stream_codec<Codec, CodecVariant>::decode(
         // overflow the array in case the input data is too long.
         ++last_index_ptr;
         while (src < src_end) {
-            *alphabet_index_ptr = alphabet_index_lookup::for_symbol(*(src++));
+            alphabet_index_t idx = alphabet_index_lookup::for_symbol(*(src++));
 
-            if (alphabet_index_info<CodecVariant>::is_eof(*alphabet_index_ptr)) {
-                *alphabet_index_ptr = alphabet_index_info<CodecVariant>::padding_idx;
+            if (alphabet_index_info<CodecVariant>::is_ignored(idx)) {
+                continue;
+            }
+            if (alphabet_index_info<CodecVariant>::is_eof(idx)) {
                 break;
             }
-            if (!alphabet_index_info<CodecVariant>::is_padding(*alphabet_index_ptr)) {
+            if (!alphabet_index_info<CodecVariant>::is_padding(idx)) {
                 throw padding_error();
             }
 
@@ -403,8 +711,90 @@ inline void stream_codec<Codec, CodecVariant>::decode(
     }
 }
 
+template <typename Codec, typename CodecVariant>
+template <typename Result, typename ResultState>
+inline void stream_codec<Codec, CodecVariant>::decode_partial(
+        Result& binary_result, ResultState& state, resumable_decode_state& decode_state,
+        const char* src, size_t src_size)
+{
+    using alphabet_index_lookup = typename alphabet_index_info<CodecVariant>::lookup;
+    using info = alphabet_index_info<CodecVariant>;
+    static_assert(Codec::encoded_block_size() <= sizeof(decode_state.indexes) / sizeof(alphabet_index_t),
+            "resumable_decode_state must hold an entire encoded block");
+
+    for (size_t i = 0; i < src_size && !decode_state.at_end; ++i) {
+        if (decode_state.num_padding) {
+            // Same as decode(): after the first padding character, only more padding,
+            // ignored characters or the end of input can follow.
+            alphabet_index_t idx = alphabet_index_lookup::for_symbol(src[i]);
+            if (info::is_ignored(idx)) {
+                continue;
+            }
+            if (info::is_eof(idx)) {
+                decode_state.at_end = true;
+                break;
+            }
+            if (!info::is_padding(idx)) {
+                throw padding_error();
+            }
+            if (decode_state.num_indexes + ++decode_state.num_padding > Codec::encoded_block_size()) {
+                throw padding_error();
+            }
+            continue;
+        }
+        alphabet_index_t idx = alphabet_index_lookup::for_symbol(src[i]);
+        if (info::is_stop_character(idx)) {
+            if (info::is_ignored(idx)) {
+                continue;
+            }
+            if (info::is_invalid(idx)) {
+                throw symbol_error(src[i], decode_state.offset + i);
+            }
+            if (info::is_padding(idx)) {
+                if (!decode_state.num_indexes) {
+                    // Don't accept padding at the start of a block.
+                    throw padding_error();
+                }
+                decode_state.num_padding = 1;
+                continue;
+            }
+            decode_state.at_end = true;
+            break;
+        }
+        decode_state.indexes[decode_state.num_indexes++] = idx;
+        if (decode_state.num_indexes == Codec::encoded_block_size()) {
+            Codec::decode_block(binary_result, state, decode_state.indexes);
+            decode_state.num_indexes = 0;
+        }
+    }
+    decode_state.offset += src_size;
+}
+
+template <typename Codec, typename CodecVariant>
+template <typename Result, typename ResultState>
+inline void stream_codec<Codec, CodecVariant>::decode_finish(
+        Result& binary_result, ResultState& state, resumable_decode_state& decode_state)
+{
+    if (decode_state.num_indexes) {
+        if ((CodecVariant::requires_padding() || decode_state.num_padding)
+                && decode_state.num_indexes + decode_state.num_padding != Codec::encoded_block_size()) {
+            // If the input is not a multiple of the block size then the input is incorrect.
+            throw padding_error();
+        }
+        Codec::decode_tail(binary_result, state, decode_state.indexes, decode_state.num_indexes);
+    }
+    decode_state = resumable_decode_state();
+}
+
 template <typename Codec, typename CodecVariant>
 inline constexpr size_t stream_codec<Codec, CodecVariant>::encoded_size(size_t binary_size) noexcept
+{
+    return encoded_size_unwrapped(binary_size)
+            + line_wrapping<CodecVariant>::line_breaks_size(encoded_size_unwrapped(binary_size));
+}
+
+template <typename Codec, typename CodecVariant>
+inline constexpr size_t stream_codec<Codec, CodecVariant>::encoded_size_unwrapped(size_t binary_size) noexcept
 {
     using C = Codec;
 
@@ -433,6 +823,220 @@ inline constexpr size_t stream_codec<Codec, CodecVariant>::decoded_max_size(size
                             * C::binary_block_size() / C::encoded_block_size());
 }
 
+template <typename Codec, typename CodecVariant>
+inline CPPCODEC_CONSTEXPR_CXX17 size_t stream_codec<Codec, CodecVariant>::decoded_size(
+        const char* src, size_t src_size) noexcept
+{
+    // Look at the input in groups without early exits inside a group, so that the compiler
+    // can vectorize the inner loop. Only once a group contains an end-of-input symbol do we
+    // need to find its exact position, because the decoder stops reading there.
+    constexpr const size_t group_size = 32;
+
+    size_t num_ignored = 0;
+    size_t end = 0;
+
+    for (; end + group_size <= src_size; end += group_size) {
+        size_t group_ignored = 0;
+        bool group_has_eof = false;
+        for (size_t i = end; i < end + group_size; ++i) {
+            group_ignored += CodecVariant::should_ignore(src[i]) ? 1 : 0;
+            group_has_eof |= CodecVariant::is_eof_symbol(src[i]);
+        }
+        if (group_has_eof) {
+            break;
+        }
+        num_ignored += group_ignored;
+    }
+    for (; end < src_size && !CodecVariant::is_eof_symbol(src[end]); ++end) {
+        num_ignored += CodecVariant::should_ignore(src[end]) ? 1 : 0;
+    }
+
+    // Padding can only occur at the end, after the last symbol (but possibly mixed with
+    // ignored characters, which have been counted already).
+    size_t num_padding = 0;
+    if (alphabet_index_info<CodecVariant>::allows_padding()) {
+        for (size_t pos = end; pos > 0; --pos) {
+            if (CodecVariant::is_padding_symbol(src[pos - 1])) {
+                ++num_padding;
+            } else if (!CodecVariant::should_ignore(src[pos - 1])) {
+                break;
+            }
+        }
+    }
+
+    // Without padding, the maximum decoded size is also the exact decoded size.
+    const size_t num_symbols = end - num_ignored - num_padding;
+    return (num_symbols / Codec::encoded_block_size() * Codec::binary_block_size())
+            + ((num_symbols % Codec::encoded_block_size())
+                    * Codec::binary_block_size() / Codec::encoded_block_size());
+}
+
+template <typename Codec, typename CodecVariant>
+inline constexpr bool stream_codec<Codec, CodecVariant>::is_valid_tail(size_t num_symbols) noexcept
+{
+    // A tail block is valid if encoding the bytes it decodes to results in the same number
+    // of symbols, e.g. a single symbol doesn't carry enough bits for a byte.
+    return (num_symbols * Codec::binary_block_size() / Codec::encoded_block_size()) != 0
+            && Codec::num_encoded_tail_symbols(static_cast<uint8_t>(
+                    num_symbols * Codec::binary_block_size() / Codec::encoded_block_size())) == num_symbols;
+}
+
+template <typename Codec, typename CodecVariant>
+inline bool stream_codec<Codec, CodecVariant>::validate(const char* src, size_t src_size) noexcept
+{
+    // Same state machine as decode(), but only counting symbols instead of storing their indexes.
+    using alphabet_index_lookup = typename alphabet_index_info<CodecVariant>::lookup;
+    using info = alphabet_index_info<CodecVariant>;
+
+    size_t num_indexes = 0; // in the current block
+    size_t num_padding = 0;
+    for (size_t i = 0; i < src_size; ++i) {
+        alphabet_index_t idx = alphabet_index_lookup::for_symbol(src[i]);
+        if (num_padding) {
+            if (info::is_ignored(idx)) {
+                continue;
+            }
+            if (info::is_eof(idx)) {
+                break;
+            }
+            if (!info::is_padding(idx) || num_indexes + ++num_padding > Codec::encoded_block_size()) {
+                return false;
+            }
+            continue;
+        }
+        if (!info::is_stop_character(idx)) {
+            if (++num_indexes == Codec::encoded_block_size()) {
+                num_indexes = 0;
+            }
+            continue;
+        }
+        if (info::is_ignored(idx)) {
+            continue;
+        }
+        if (info::is_invalid(idx)) {
+            return false;
+        }
+        if (!info::is_padding(idx)) {
+            break; // end of input
+        }
+        if (!num_indexes) {
+            return false; // padding at the start of a block
+        }
+        num_padding = 1;
+    }
+
+    if (!num_indexes) {
+        return true;
+    }
+    if ((CodecVariant::requires_padding() || num_padding)
+            && num_indexes + num_padding != Codec::encoded_block_size()) {
+        return false;
+    }
+    return is_valid_tail(num_indexes);
+}
+
+template <typename Codec, typename CodecVariant>
+inline size_t stream_codec<Codec, CodecVariant>::count_symbols(
+        const char* src, size_t src_size, size_t& num_symbols) noexcept
+{
+    size_t num_ignored = 0;
+    size_t end = 0;
+    for (; end < src_size && !CodecVariant::is_eof_symbol(src[end]); ++end) {
+        num_ignored += CodecVariant::should_ignore(src[end]) ? 1 : 0;
+    }
+    num_symbols = end - num_ignored;
+    return end;
+}
+
+template <typename Codec, typename CodecVariant>
+inline constexpr bool stream_codec<Codec, CodecVariant>::ignores_characters() noexcept
+{
+    return alphabet_index_info<CodecVariant>::allows_ignored();
+}
+
+template <typename Codec, typename CodecVariant>
+inline size_t stream_codec<Codec, CodecVariant>::skip_symbols(
+        const char* src, size_t src_size, size_t num_symbols) noexcept
+{
+    size_t pos = 0;
+    for (; num_symbols && pos < src_size; ++pos) {
+        num_symbols -= CodecVariant::should_ignore(src[pos]) ? 0 : 1;
+    }
+    return pos;
+}
+
+template <typename Codec, typename CodecVariant>
+template <size_t NumLanes>
+inline uint_fast32_t stream_codec<Codec, CodecVariant>::decode_lanes(
+        uint8_t* binary, size_t binary_size, const char* encoded, size_t encoded_size) noexcept
+{
+    static_assert(NumLanes > 0 && NumLanes <= 32, "lane mask must fit into uint_fast32_t");
+
+    using alphabet_index_lookup = typename alphabet_index_info<CodecVariant>::lookup;
+    constexpr const size_t ebs = Codec::encoded_block_size();
+    constexpr const size_t bbs = Codec::binary_block_size();
+    constexpr const uint_fast32_t all_lanes = static_cast<uint_fast32_t>(~0ull >> (64 - NumLanes));
+
+    // All lanes share the same shape, so a tail that decode() would reject is rejected for all.
+    const size_t num_blocks = encoded_size / ebs;
+    const size_t num_tail_symbols = encoded_size % ebs;
+    const size_t num_tail_bytes = num_tail_symbols * bbs / ebs;
+    if (num_blocks * bbs + num_tail_bytes != binary_size) {
+        return all_lanes;
+    }
+    if (num_tail_symbols && (CodecVariant::requires_padding() || !num_tail_bytes
+            || Codec::num_encoded_tail_symbols(static_cast<uint8_t>(num_tail_bytes)) != num_tail_symbols)) {
+        return all_lanes;
+    }
+
+    alphabet_index_t alphabet_indexes[NumLanes][ebs];
+    alphabet_index_t lane_flags[NumLanes] = {};
+
+    for (size_t block = 0; block < num_blocks; ++block) {
+        // Look up one block of every lane first. Unlike in decode(), the lookups don't depend
+        // on the previous symbol not being a stop character, so they can all be in flight at once.
+        // Stop characters are only detected afterwards, by or-ing all indexes of a lane together.
+        for (size_t lane = 0; lane < NumLanes; ++lane) {
+            const char* src = encoded + lane * encoded_size + block * ebs;
+            for (size_t i = 0; i < ebs; ++i) {
+                alphabet_indexes[lane][i] = alphabet_index_lookup::for_symbol(src[i]);
+                lane_flags[lane] |= alphabet_indexes[lane][i];
+            }
+        }
+        for (size_t lane = 0; lane < NumLanes; ++lane) {
+            if (!alphabet_index_info<CodecVariant>::is_stop_character(lane_flags[lane])) {
+                lane_result result(binary + lane * binary_size + block * bbs);
+                auto state = data::create_state(result, data::specific_t());
+                Codec::decode_block(result, state, alphabet_indexes[lane]);
+            }
+        }
+    }
+    if (num_tail_symbols) {
+        for (size_t lane = 0; lane < NumLanes; ++lane) {
+            const char* src = encoded + lane * encoded_size + num_blocks * ebs;
+            for (size_t i = 0; i < num_tail_symbols; ++i) {
+                alphabet_indexes[lane][i] = alphabet_index_lookup::for_symbol(src[i]);
+                lane_flags[lane] |= alphabet_indexes[lane][i];
+            }
+        }
+        for (size_t lane = 0; lane < NumLanes; ++lane) {
+            if (!alphabet_index_info<CodecVariant>::is_stop_character(lane_flags[lane])) {
+                lane_result result(binary + lane * binary_size + num_blocks * bbs);
+                auto state = data::create_state(result, data::specific_t());
+                Codec::decode_tail(result, state, alphabet_indexes[lane], num_tail_symbols);
+            }
+        }
+    }
+
+    uint_fast32_t fallback_lanes = 0;
+    for (size_t lane = 0; lane < NumLanes; ++lane) {
+        if (alphabet_index_info<CodecVariant>::is_stop_character(lane_flags[lane])) {
+            fallback_lanes |= static_cast<uint_fast32_t>(1) << lane;
+        }
+    }
+    return fallback_lanes;
+}
+
 } // namespace detail
 } // namespace cppcodec
 
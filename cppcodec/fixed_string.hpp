@@ -0,0 +1,120 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+
+#ifndef CPPCODEC_FIXED_STRING
+#define CPPCODEC_FIXED_STRING
+
+#include <stdint.h>
+#include <stdlib.h> // for abort()
+
+#include "detail/config.hpp" // for CPPCODEC_CONSTEXPR_CXX17
+
+namespace cppcodec {
+
+// Stack-allocated result type with a fixed capacity of N characters (plus null termination).
+// It never allocates memory, so it's a good fit for encoding keys, digests and UUIDs
+// whose size is known at compile time. Like raw_result_buffer, it calls abort()
+// if more than N characters are requested, rather than throwing.
+template <size_t N, typename CharT = char>
+class fixed_string
+{
+public:
+    using value_type = CharT;
+    using size_type = size_t;
+    using iterator = CharT*;
+    using const_iterator = const CharT*;
+
+    constexpr fixed_string() : m_data(), m_size(0) { }
+
+    static constexpr size_t capacity() noexcept { return N; }
+    static constexpr size_t max_size() noexcept { return N; }
+
+    constexpr size_t size() const noexcept { return m_size; }
+    constexpr bool empty() const noexcept { return m_size == 0; }
+
+    CPPCODEC_CONSTEXPR_CXX17 CharT* data() noexcept { return m_data; }
+    constexpr const CharT* data() const noexcept { return m_data; }
+    constexpr const CharT* c_str() const noexcept { return m_data; }
+
+    CPPCODEC_CONSTEXPR_CXX17 CharT& operator[](size_t i) noexcept { return m_data[i]; }
+    constexpr const CharT& operator[](size_t i) const noexcept { return m_data[i]; }
+
+    CPPCODEC_CONSTEXPR_CXX17 iterator begin() noexcept { return m_data; }
+    CPPCODEC_CONSTEXPR_CXX17 iterator end() noexcept { return m_data + m_size; }
+    constexpr const_iterator begin() const noexcept { return m_data; }
+    constexpr const_iterator end() const noexcept { return m_data + m_size; }
+
+    CPPCODEC_CONSTEXPR_CXX17 void reserve(size_t capacity) const noexcept
+    {
+        if (capacity > N) {
+            abort();
+        }
+    }
+    CPPCODEC_CONSTEXPR_CXX17 void resize(size_t size) noexcept
+    {
+        reserve(size);
+        m_size = size;
+        m_data[m_size] = CharT();
+    }
+    CPPCODEC_CONSTEXPR_CXX17 void clear() noexcept { resize(0); }
+    CPPCODEC_CONSTEXPR_CXX17 void push_back(CharT c) noexcept
+    {
+        reserve(m_size + 1);
+        m_data[m_size++] = c;
+        m_data[m_size] = CharT();
+    }
+
+private:
+    CharT m_data[N + 1];
+    size_t m_size;
+};
+
+template <size_t N>
+using fixed_bytes = fixed_string<N, uint8_t>;
+
+template <size_t N, size_t M, typename CharT>
+inline CPPCODEC_CONSTEXPR_CXX17 bool operator==(
+        const fixed_string<N, CharT>& lhs, const fixed_string<M, CharT>& rhs) noexcept
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t N, size_t M, typename CharT>
+inline CPPCODEC_CONSTEXPR_CXX17 bool operator!=(
+        const fixed_string<N, CharT>& lhs, const fixed_string<M, CharT>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_FIXED_STRING
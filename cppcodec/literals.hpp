@@ -0,0 +1,88 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_LITERALS
+#define CPPCODEC_LITERALS
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base32_rfc4648.hpp"
+#include "base64_rfc4648.hpp"
+#include "base64_url_unpadded.hpp"
+#include "hex_lower.hpp"
+
+// User-defined literals need string literals as class-type template arguments (C++20).
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+
+namespace cppcodec {
+
+namespace detail {
+
+template <size_t N>
+struct string_literal
+{
+    constexpr string_literal(const char (&str)[N])
+    {
+        for (size_t i = 0; i < N; ++i) {
+            value[i] = str[i];
+        }
+    }
+    static constexpr size_t size() { return N - 1; } // without the terminating '\0'
+
+    char value[N] = {};
+};
+
+template <typename Codec, string_literal Encoded>
+constexpr auto decode_literal()
+{
+    constexpr size_t binary_size = Codec::decoded_size(Encoded.value, Encoded.size());
+    return Codec::template decode_array<binary_size>(Encoded.value, Encoded.size());
+}
+
+} // namespace detail
+
+// Decodes at compile time, e.g. constexpr auto key = "3q2+7w=="_b64; -> std::array<uint8_t, 4>
+// Invalid input is a compile error.
+namespace literals {
+
+template <detail::string_literal Encoded>
+constexpr auto operator""_b64() { return detail::decode_literal<base64_rfc4648, Encoded>(); }
+
+template <detail::string_literal Encoded>
+constexpr auto operator""_b64url() { return detail::decode_literal<base64_url_unpadded, Encoded>(); }
+
+template <detail::string_literal Encoded>
+constexpr auto operator""_b32() { return detail::decode_literal<base32_rfc4648, Encoded>(); }
+
+template <detail::string_literal Encoded>
+constexpr auto operator""_hex() { return detail::decode_literal<hex_lower, Encoded>(); }
+
+} // namespace literals
+
+} // namespace cppcodec
+
+#endif // __cpp_nontype_template_args >= 201911L
+
+#endif // CPPCODEC_LITERALS
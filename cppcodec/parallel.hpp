@@ -0,0 +1,284 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_PARALLEL
+#define CPPCODEC_PARALLEL
+
+#include <exception>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h> // for abort()
+#include <thread>
+#include <vector>
+
+#include "data/access.hpp"
+#include "data/raw_result_buffer.hpp"
+#include "detail/codec.hpp"
+#include "detail/config.hpp"
+#include "parse_error.hpp"
+
+// Multi-threaded encoding/decoding of large buffers. Opt-in, as this requires linking against
+// the platform's thread library (e.g. -pthread, or Threads::Threads in CMake).
+
+namespace cppcodec {
+
+namespace detail {
+
+// Don't spin up threads for chunks that take less time to encode than to start a thread.
+static constexpr const size_t parallel_min_chunk_size = 64 * 1024;
+
+inline unsigned parallel_num_threads(unsigned num_threads, size_t size)
+{
+    if (!num_threads) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    size_t max_threads = size / parallel_min_chunk_size;
+    if (num_threads > max_threads) {
+        num_threads = static_cast<unsigned>(max_threads);
+    }
+    return num_threads ? num_threads : 1;
+}
+
+// Runs chunk_fn(i) for i in [0, num_chunks), the first one on the calling thread.
+// All threads that were started are joined before an exception leaves this function:
+// if a thread can't be started, that exception is rethrown without running any chunk on the
+// calling thread, otherwise the exception of the first chunk that threw (if any).
+template <typename ChunkFn>
+inline void parallel_for_chunks(unsigned num_chunks, const ChunkFn& chunk_fn)
+{
+    std::vector<std::exception_ptr> errors(num_chunks);
+    auto run_chunk = [&](unsigned i) {
+        try {
+            chunk_fn(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    std::exception_ptr start_error;
+    try {
+        threads.reserve(num_chunks - 1);
+        for (unsigned i = 1; i < num_chunks; ++i) {
+            threads.emplace_back(run_chunk, i);
+        }
+    } catch (...) {
+        start_error = std::current_exception();
+    }
+    if (!start_error) {
+        run_chunk(0);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (start_error) {
+        std::rethrow_exception(start_error);
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+// A range of encoded input that starts at a multiple of the encoded block size in terms of
+// symbols, so it can be decoded independently from the others.
+struct parallel_decode_chunk
+{
+    size_t begin; // position in the encoded input
+    size_t end;
+    size_t binary_offset; // decoded bytes before this chunk
+    size_t binary_size; // decoded bytes written by this chunk
+    std::exception_ptr error;
+};
+
+} // namespace detail
+
+// Encode binary data on num_threads threads (0: one per hardware thread) into
+// pre-allocated memory with a buffer size of Codec::encoded_size(binary_size) or larger.
+// The input is split at multiples of Codec::binary_block_size(), so that each chunk's output
+// offset is given by encoded_size() and only the last chunk has a tail and padding.
+template <typename Codec>
+inline size_t encode_parallel(
+        char* encoded_result, size_t encoded_buffer_size,
+        const uint8_t* binary, size_t binary_size, unsigned num_threads = 0)
+{
+    using codec_impl = typename detail::codec_impl_of<Codec>::type;
+
+    const size_t encoded_size = Codec::encoded_size(binary_size);
+    if (encoded_buffer_size < encoded_size) {
+        abort();
+    }
+    unsigned num_chunks = detail::parallel_num_threads(num_threads, binary_size);
+    size_t num_blocks = binary_size / Codec::binary_block_size();
+    size_t chunk_size = (num_blocks + num_chunks - 1) / num_chunks * Codec::binary_block_size();
+
+    detail::parallel_for_chunks(num_chunks, [=](unsigned i) {
+        size_t offset = i * chunk_size;
+        if (offset >= binary_size) {
+            return;
+        }
+        size_t size = (i + 1 == num_chunks || binary_size - offset < chunk_size)
+                ? binary_size - offset : chunk_size;
+        // Continue where the previous chunk leaves off, so that codecs that wrap lines
+        // start this chunk with a line break if the previous line is full.
+        size_t encoded_offset = Codec::encoded_size(offset);
+        size_t chunk_encoded_size = Codec::encoded_size(offset + size) - encoded_offset;
+        size_t num_symbols = offset / Codec::binary_block_size() * Codec::encoded_block_size();
+
+        data::raw_result_buffer encoded(encoded_result + encoded_offset, chunk_encoded_size);
+        auto state = data::create_state(encoded, data::specific_t());
+        data::init(encoded, state, chunk_encoded_size);
+        codec_impl::encode_continued(encoded, state, binary + offset, size, num_symbols);
+        data::finish(encoded, state);
+    });
+
+    if (encoded_size < encoded_buffer_size) {
+        encoded_result[encoded_size] = '\0';
+    }
+    return encoded_size;
+}
+
+// Same as above, but resizes a contiguous encoded_result (such as std::string) to fit.
+template <typename Codec, typename Result>
+inline void encode_parallel(
+        Result& encoded_result, const uint8_t* binary, size_t binary_size, unsigned num_threads = 0)
+{
+    encoded_result.resize(Codec::encoded_size(binary_size));
+    if (encoded_result.empty()) {
+        return;
+    }
+    encode_parallel<Codec>(reinterpret_cast<char*>(&encoded_result[0]), encoded_result.size(),
+            binary, binary_size, num_threads);
+}
+
+// Decode an encoded string on num_threads threads (0: one per hardware thread) into
+// pre-allocated memory with a buffer size of Codec::decoded_max_size(encoded_size) or larger.
+// Returns the decoded size and throws the same exceptions as Codec::decode().
+template <typename Codec>
+inline size_t decode_parallel(
+        uint8_t* binary_result, size_t binary_buffer_size,
+        const char* encoded, size_t encoded_size, unsigned num_threads = 0)
+{
+    using impl = typename detail::codec_impl_of<Codec>::type;
+    using chunk_t = detail::parallel_decode_chunk;
+
+    if (binary_buffer_size < Codec::decoded_max_size(encoded_size)) {
+        abort();
+    }
+    const size_t ebs = Codec::encoded_block_size();
+    unsigned num_chunks = detail::parallel_num_threads(num_threads, encoded_size);
+    size_t chunk_size = (encoded_size + num_chunks - 1) / num_chunks;
+    auto chunk_begin = [=](unsigned i) {
+        return (i * chunk_size < encoded_size) ? i * chunk_size : encoded_size;
+    };
+
+    // Ignored characters such as line breaks make it impossible to tell where a block starts
+    // from the position alone. So first count the symbols in equally sized chunks of input.
+    std::vector<size_t> chunk_ends(num_chunks);
+    std::vector<size_t> chunk_symbols(num_chunks);
+    detail::parallel_for_chunks(num_chunks, [&](unsigned i) {
+        size_t begin = chunk_begin(i);
+        chunk_ends[i] = begin + impl::count_symbols(
+                encoded + begin, chunk_begin(i + 1) - begin, chunk_symbols[i]);
+    });
+
+    // Decoding stops at the first end-of-input symbol, and so does splitting.
+    size_t input_end = encoded_size;
+    for (unsigned i = 0; i < num_chunks; ++i) {
+        if (chunk_ends[i] < chunk_begin(i + 1)) {
+            input_end = chunk_ends[i];
+            num_chunks = i + 1;
+            break;
+        }
+    }
+
+    // Then move each chunk boundary forward until the number of symbols before it is a multiple
+    // of the encoded block size. Chunks with too few symbols to get there are merged.
+    std::vector<chunk_t> chunks(1, chunk_t{ 0, input_end, 0, 0, std::exception_ptr() });
+    size_t num_symbols = chunk_symbols[0];
+    for (unsigned i = 1; i < num_chunks; ++i) {
+        size_t num_block_symbols = (num_symbols + ebs - 1) / ebs * ebs;
+        size_t num_skipped = num_block_symbols - num_symbols;
+        num_symbols += chunk_symbols[i];
+        if (chunk_symbols[i] <= num_skipped) {
+            continue;
+        }
+        size_t begin = chunk_begin(i);
+        begin += impl::skip_symbols(encoded + begin, chunk_ends[i] - begin, num_skipped);
+        chunks.back().end = begin;
+        chunks.push_back(chunk_t{ begin, input_end, num_block_symbols / ebs * Codec::binary_block_size(),
+                0, std::exception_ptr() });
+    }
+
+    // Finally, decode all chunks concurrently, each into its own part of the output.
+    detail::parallel_for_chunks(static_cast<unsigned>(chunks.size()), [&](unsigned i) {
+        chunk_t& chunk = chunks[i];
+        bool is_last = (i + 1 == chunks.size());
+        size_t capacity = is_last ? Codec::decoded_max_size(chunk.end - chunk.begin)
+                : chunks[i + 1].binary_offset - chunk.binary_offset;
+
+        data::raw_result_buffer binary(
+                reinterpret_cast<char*>(binary_result + chunk.binary_offset), capacity);
+        binary.resize(0);
+        auto state = data::create_state(binary, data::specific_t());
+        try {
+            impl::decode(binary, state, encoded + chunk.begin, chunk.end - chunk.begin);
+            data::finish(binary, state);
+            chunk.binary_size = data::size(binary);
+            if (!is_last && chunk.binary_size != capacity) {
+                // Padding (or an end of input) before the last block of the whole input.
+                throw padding_error();
+            }
+        } catch (const symbol_error& e) {
+            chunk.error = std::make_exception_ptr(symbol_error(e.symbol(), chunk.begin + e.offset()));
+        } catch (const parse_error&) {
+            chunk.error = std::current_exception();
+        }
+    });
+
+    for (auto& chunk : chunks) {
+        if (chunk.error) {
+            std::rethrow_exception(chunk.error); // the first one, same as for sequential decoding
+        }
+    }
+    return chunks.back().binary_offset + chunks.back().binary_size;
+}
+
+// Same as above, but resizes a contiguous binary_result (such as std::vector<uint8_t>) to fit.
+template <typename Codec, typename Result>
+inline void decode_parallel(
+        Result& binary_result, const char* encoded, size_t encoded_size, unsigned num_threads = 0)
+{
+    binary_result.resize(Codec::decoded_max_size(encoded_size));
+    if (binary_result.empty()) {
+        return;
+    }
+    binary_result.resize(decode_parallel<Codec>(reinterpret_cast<uint8_t*>(&binary_result[0]),
+            binary_result.size(), encoded, encoded_size, num_threads));
+}
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_PARALLEL
@@ -24,6 +24,7 @@
 #ifndef CPPCODEC_PARSE_ERROR
 #define CPPCODEC_PARSE_ERROR
 
+#include <stddef.h> // for size_t
 #include <stdexcept>
 #include <string>
 
@@ -65,15 +66,18 @@ public:
 class symbol_error : public parse_error
 {
 public:
-    symbol_error(char c)
+    symbol_error(char c, size_t offset = 0)
         : parse_error(symbol_error::make_error_message(c))
         , m_symbol(c)
+        , m_offset(offset)
     {
     }
 
     symbol_error(const symbol_error&) = default;
 
     char symbol() const noexcept { return m_symbol; }
+    // Position of the offending character in the encoded input.
+    size_t offset() const noexcept { return m_offset; }
 
 private:
     static std::string make_error_message(char c)
@@ -85,6 +89,7 @@ private:
 
 private:
     char m_symbol;
+    size_t m_offset;
 };
 
 class invalid_input_length : public parse_error
@@ -104,6 +109,18 @@ public:
     padding_error(const padding_error&) = default;
 };
 
+// For codecs with a mandatory checksum, such as base64_openpgp: missing or not matching the data.
+class checksum_error : public parse_error
+{
+public:
+    checksum_error()
+        : parse_error("parse error: checksum is missing or doesn't match the decoded data")
+    {
+    }
+
+    checksum_error(const checksum_error&) = default;
+};
+
 } // namespace cppcodec
 
 #endif // CPPCODEC_PARSE_ERROR
@@ -0,0 +1,210 @@
+/**
+ *  Copyright (C) 2016 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_PEM_SCANNER
+#define CPPCODEC_PEM_SCANNER
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h> // for abort()
+#include <string.h> // for memchr(), memcmp(), strlen()
+#include <vector>
+
+#include "base64_pem.hpp"
+#include "data/access.hpp"
+#include "data/raw_result_buffer.hpp"
+#include "parse_error.hpp"
+
+// Finding and decoding PEM blocks ("-----BEGIN CERTIFICATE-----" ... "-----END CERTIFICATE-----")
+// in a larger buffer such as a CA bundle, without copying the encoded text.
+
+namespace cppcodec {
+
+// A PEM block within the scanned buffer. Label and encoded text point into that buffer.
+struct pem_block
+{
+    const char* label = nullptr; // e.g. "CERTIFICATE", not null-terminated
+    size_t label_size = 0;
+    const char* encoded = nullptr; // base64 text between the BEGIN (or header) and END lines
+    size_t encoded_size = 0;
+    const char* headers = nullptr; // RFC 1421 header lines such as "Proc-Type: 4,ENCRYPTED"
+    size_t headers_size = 0; // 0 if there are none
+    size_t offset = 0; // position of the BEGIN line in the scanned buffer
+
+    bool has_label(const char* str) const noexcept
+    {
+        return strlen(str) == label_size && memcmp(str, label, label_size) == 0;
+    }
+
+    size_t decoded_size() const noexcept { return base64_pem::decoded_size(encoded, encoded_size); }
+
+    template <typename Result = std::vector<uint8_t>> Result decode() const
+    {
+        return base64_pem::decode<Result>(encoded, encoded_size);
+    }
+    template <typename Result> void decode(Result& binary_result) const
+    {
+        base64_pem::decode(binary_result, encoded, encoded_size);
+    }
+
+    // Raw pointer output with a buffer size of decoded_size() or larger, so that blocks
+    // can be decoded back to back into the same buffer. Calls abort() if it's too small.
+    size_t decode(uint8_t* binary_result, size_t binary_buffer_size) const
+    {
+        using codec_impl = detail::codec_impl_of<base64_pem>::type;
+
+        // Only count the exact decoded size (an extra pass) if the maximum size doesn't fit.
+        size_t capacity = base64_pem::decoded_max_size(encoded_size);
+        if (binary_buffer_size < capacity) {
+            capacity = decoded_size();
+            if (binary_buffer_size < capacity) {
+                abort();
+            }
+        }
+        data::raw_result_buffer binary(reinterpret_cast<char*>(binary_result), capacity);
+        auto state = data::create_state(binary, data::specific_t());
+        data::init(binary, state, capacity);
+        codec_impl::decode(binary, state, encoded, encoded_size);
+        data::finish(binary, state);
+        return data::size(binary);
+    }
+};
+
+// Iterates over the PEM blocks in a buffer, skipping any text in between:
+//
+//     cppcodec::pem_scanner scanner(bundle);
+//     cppcodec::pem_block block;
+//     while (scanner.next(block)) {
+//         if (block.has_label("CERTIFICATE")) { ... block.decode(der) ... }
+//     }
+//
+// The END line is found by searching for "\n-----END " at the start of a line. RFC 1421 headers
+// (e.g. "Proc-Type: 4,ENCRYPTED" and "DEK-Info: ..." in legacy encrypted keys), which RFC 7468
+// dropped, end at the first empty line. They are skipped and made available as block.headers,
+// so that encoded only holds the base64 text. Without an empty line after the headers,
+// they stay in the encoded text and decoding that block throws a symbol_error.
+class pem_scanner
+{
+public:
+    pem_scanner(const char* data, size_t size) : m_begin(data), m_pos(data), m_end(data + size) { }
+    template <typename T> explicit pem_scanner(const T& data)
+        : pem_scanner(data::char_data(data), data::size(data)) { }
+    // Blocks point into the scanned buffer, so it must outlive the scanner.
+    template <typename T> explicit pem_scanner(const T&& data) = delete;
+
+    // Finds the next PEM block and returns true, or returns false if there are no more.
+    // Throws parse_error if a BEGIN line is unterminated or lacks a matching END line.
+    bool next(pem_block& block)
+    {
+        static constexpr const char begin_marker[] = "-----BEGIN ";
+        static constexpr const char end_marker[] = "\n-----END ";
+        static constexpr const size_t begin_marker_size = sizeof(begin_marker) - 1;
+        static constexpr const size_t end_marker_size = sizeof(end_marker) - 1;
+
+        const char* begin = find(m_pos, begin_marker, begin_marker_size);
+        if (!begin) {
+            m_pos = m_end;
+            return false;
+        }
+        const char* label = begin + begin_marker_size;
+        const char* label_end = find(label, "-----", 5);
+        if (!label_end || memchr(label, '\n', static_cast<size_t>(label_end - label))) {
+            throw parse_error("parse error: unterminated PEM BEGIN line");
+        }
+        const char* encoded = label_end + 5;
+        size_t label_size = static_cast<size_t>(label_end - label);
+
+        const char* end = find(encoded, end_marker, end_marker_size);
+        if (!end
+                || static_cast<size_t>(m_end - end) < end_marker_size + label_size + 5
+                || memcmp(end + end_marker_size, label, label_size) != 0
+                || memcmp(end + end_marker_size + label_size, "-----", 5) != 0) {
+            throw parse_error("parse error: PEM block without matching END line");
+        }
+        const char* headers_end = find_headers_end(encoded, end);
+
+        block.label = label;
+        block.label_size = label_size;
+        block.headers = encoded;
+        block.headers_size = static_cast<size_t>(headers_end - encoded);
+        block.encoded = headers_end;
+        block.encoded_size = static_cast<size_t>(end - headers_end);
+        block.offset = static_cast<size_t>(begin - m_begin);
+        m_pos = end + end_marker_size + label_size + 5;
+        return true;
+    }
+
+private:
+    // Returns the position after the empty line that ends the RFC 1421 headers at the start
+    // of body, or body itself if the first line is no header (i.e. has no ':').
+    static const char* find_headers_end(const char* body, const char* body_end) noexcept
+    {
+        const char* line = body;
+        if (line < body_end && *line == '\r') {
+            ++line;
+        }
+        if (line < body_end && *line == '\n') { // rest of the BEGIN line
+            ++line;
+        }
+        const char* line_end = static_cast<const char*>(
+                memchr(line, '\n', static_cast<size_t>(body_end - line)));
+        if (!line_end || !memchr(line, ':', static_cast<size_t>(line_end - line))) {
+            return body;
+        }
+        while (line_end) {
+            line = line_end + 1;
+            if (line < body_end && *line == '\r') {
+                ++line;
+            }
+            if (line < body_end && *line == '\n') {
+                return line + 1;
+            }
+            line_end = static_cast<const char*>(
+                    memchr(line, '\n', static_cast<size_t>(body_end - line)));
+        }
+        return body;
+    }
+
+    const char* find(const char* pos, const char* str, size_t str_size) const noexcept
+    {
+        while (static_cast<size_t>(m_end - pos) >= str_size) {
+            pos = static_cast<const char*>(memchr(pos, str[0], static_cast<size_t>(m_end - pos)));
+            if (!pos || static_cast<size_t>(m_end - pos) < str_size) {
+                return nullptr;
+            }
+            if (memcmp(pos, str, str_size) == 0) {
+                return pos;
+            }
+            ++pos;
+        }
+        return nullptr;
+    }
+
+    const char* m_begin;
+    const char* m_pos;
+    const char* m_end;
+};
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_PEM_SCANNER
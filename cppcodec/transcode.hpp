@@ -0,0 +1,163 @@
+/**
+ *  Copyright (C) 2015 Topology LP
+ *  All rights reserved.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to
+ *  deal in the Software without restriction, including without limitation the
+ *  rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ *  sell copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ *  THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+#ifndef CPPCODEC_TRANSCODE
+#define CPPCODEC_TRANSCODE
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "data/access.hpp"
+#include "detail/codec.hpp"
+#include "detail/config.hpp"
+
+// Conversion from one encoding to another, e.g. from hex to base64url, without decoding
+// into an intermediate binary buffer first.
+
+namespace cppcodec {
+
+namespace detail {
+
+// Result type for the decoder that collects binary data in a small on-stack window.
+// Whenever the window is full, it's encoded straight into the final result. The window size
+// is a multiple of the encoder's binary block size, so only the last window has a tail.
+template <typename ToCodecImpl, typename Result, typename ResultState>
+class transcode_window
+{
+public:
+    static constexpr const size_t window_size = ToCodecImpl::binary_block_size() * 64;
+
+    transcode_window(Result& encoded_result, ResultState& state)
+        : m_result(encoded_result), m_state(state)
+    {
+    }
+
+    CPPCODEC_ALWAYS_INLINE void push_back(char c)
+    {
+        m_window[m_size++] = static_cast<uint8_t>(c);
+        if (m_size == window_size) {
+            ToCodecImpl::encode_continued(m_result, m_state, m_window, window_size, m_num_symbols);
+            m_size = 0;
+        }
+    }
+
+    // Encodes the rest of the window, including the encoder's tail and padding.
+    void finish()
+    {
+        ToCodecImpl::encode_continued(m_result, m_state, m_window, m_size, m_num_symbols);
+        m_size = 0;
+    }
+
+private:
+    Result& m_result;
+    ResultState& m_state;
+    uint8_t m_window[window_size];
+    size_t m_size = 0;
+    size_t m_num_symbols = 0;
+};
+
+// SFINAE: Codecs with a checksum over all of the data, such as base64_openpgp, delete
+// encode_continued() because they can't encode piece by piece.
+template <typename CodecImpl>
+struct has_encode_continued
+{
+    template <typename C> static auto test(int) -> decltype(C::encode_continued(
+            std::declval<std::string&>(), std::declval<data::empty_result_state&>(),
+            static_cast<const uint8_t*>(nullptr), size_t(), std::declval<size_t&>()), std::true_type());
+    template <typename C> static std::false_type test(...);
+
+    static constexpr const bool value = decltype(test<CodecImpl>(0))::value;
+};
+
+// Fallback for those: decode into a binary buffer, then encode all of it at once.
+template <typename FromCodec, typename ToCodec, typename Result>
+inline void transcode(Result& encoded_result, const char* encoded, size_t encoded_size,
+        std::false_type /*has_encode_continued*/)
+{
+    std::vector<uint8_t> binary = FromCodec::decode(encoded, encoded_size);
+    ToCodec::encode(encoded_result, binary);
+}
+
+template <typename FromCodec, typename ToCodec, typename Result>
+inline void transcode(Result& encoded_result, const char* encoded, size_t encoded_size,
+        std::true_type /*has_encode_continued*/)
+{
+    using from_impl = typename codec_impl_of<FromCodec>::type;
+    using to_impl = typename codec_impl_of<ToCodec>::type;
+
+    // Reserve for the maximum size, the same way as decode() does.
+    size_t encoded_buffer_size = ToCodec::encoded_size(FromCodec::decoded_max_size(encoded_size));
+    auto state = data::create_state(encoded_result, data::specific_t());
+    data::init(encoded_result, state, encoded_buffer_size);
+
+    transcode_window<to_impl, Result, decltype(state)> window(encoded_result, state);
+    data::empty_result_state window_state;
+    from_impl::decode(window, window_state, encoded, encoded_size);
+    window.finish();
+
+    data::finish(encoded_result, state);
+    assert(data::size(encoded_result) <= encoded_buffer_size);
+}
+
+} // namespace detail
+
+// Decode an encoded string with FromCodec and encode the result with ToCodec into
+// encoded_result, in a single pass. Throws the same exceptions as FromCodec::decode().
+// If ToCodec has a checksum over all of the data, the decoded data is buffered instead.
+template <typename FromCodec, typename ToCodec, typename Result>
+inline void transcode(Result& encoded_result, const char* encoded, size_t encoded_size)
+{
+    using to_impl = typename detail::codec_impl_of<ToCodec>::type;
+    detail::transcode<FromCodec, ToCodec>(encoded_result, encoded, encoded_size,
+            std::integral_constant<bool, detail::has_encode_continued<to_impl>::value>());
+}
+
+template <typename FromCodec, typename ToCodec, typename Result, typename T>
+inline void transcode(Result& encoded_result, const T& encoded)
+{
+    transcode<FromCodec, ToCodec>(encoded_result, data::char_data(encoded), data::size(encoded));
+}
+
+// Convenient version, returns an std::string.
+template <typename FromCodec, typename ToCodec, typename Result = std::string>
+inline Result transcode(const char* encoded, size_t encoded_size)
+{
+    Result encoded_result;
+    transcode<FromCodec, ToCodec>(encoded_result, encoded, encoded_size);
+    return encoded_result;
+}
+
+template <typename FromCodec, typename ToCodec, typename Result = std::string, typename T = std::string>
+inline Result transcode(const T& encoded)
+{
+    return transcode<FromCodec, ToCodec, Result>(data::char_data(encoded), data::size(encoded));
+}
+
+} // namespace cppcodec
+
+#endif // CPPCODEC_TRANSCODE
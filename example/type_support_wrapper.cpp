@@ -40,6 +40,9 @@
 // push_back(char) and size() methods, implement template specializations
 // for init() and finish() for the result type, and call encode()/decode()
 // with an object of this type as result parameter.
+//
+// (Appending to a string is only used as an illustration here. For this
+// particular use case, cppcodec provides encode_append()/decode_append().)
 
 class string_append_wrapper
 {
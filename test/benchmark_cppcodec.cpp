@@ -24,6 +24,7 @@
 #include <cppcodec/hex_lower.hpp>
 #include <cppcodec/base32_rfc4648.hpp>
 #include <cppcodec/base64_rfc4648.hpp>
+#include <cppcodec/constant_time.hpp>
 
 #include <chrono>
 #include <iostream>
@@ -160,5 +161,7 @@ int main()
     };
     std::cout << "base64_rfc4648: [decoded size: microseconds]\n";
     benchmark<cppcodec::base64_rfc4648>(std::cout, decoded_sizes);
+    std::cout << "constant_time<base64_rfc4648>: [decoded size: microseconds]\n";
+    benchmark<cppcodec::constant_time<cppcodec::base64_rfc4648>>(std::cout, decoded_sizes);
     return 0;
 }